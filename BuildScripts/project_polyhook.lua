@@ -38,7 +38,7 @@ project "PolyHook2"
 	filter "system:windows"
 		systemversion "latest"
 		debugdir( "../bin/".. outputDir.. "/%{prj.name}" )
-		vectorextensions( _SIMD_MODE )
+		vectorextensions "SSE2"
 		characterset "MBCS"
 		intrinsics "On"
 		fpu "Hardware"
@@ -0,0 +1,83 @@
+-- Stand-alone builds of the math code against Tests/common/pch.h instead of the plugin pch
+-- These don't need SKSE or Windows, on linux: premake5 gmake2 && make -C Tests config=release
+local outputDir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
+local loc = "../Tests"
+local kernels = "../SmoothCam/source/simd/kernels_"
+
+workspace "SmoothCamTests"
+	location( loc )
+	architecture "x64"
+	configurations { "Debug", "Release" }
+	startproject "SmoothCamTests"
+
+-- Opens a console project with the plugin's math sources in it, add the project's own files after calling this
+local function mathProject( name )
+	project( name )
+		location( loc )
+		language "C++"
+		compileas "C++"
+		cppdialect "C++17"
+		kind "ConsoleApp"
+
+		targetdir( loc.. "/bin/".. outputDir.. "/%{prj.name}" )
+		objdir( loc.. "/bin-obj/".. outputDir.. "/%{prj.name}" )
+
+		files {
+			"../SmoothCam/include/mmath.h",
+			"../SmoothCam/include/mmath_simd.h",
+			"../SmoothCam/source/mmath.cpp",
+			"../SmoothCam/source/mmath_simd.cpp",
+			"../SmoothCam/source/simd/kernels.inl",
+			kernels.. "*.cpp",
+			loc.. "/common/**.h",
+		}
+
+		-- The stand-in pch has to be found before the plugin's own
+		forceincludes { "pch.h" }
+		includedirs {
+			loc.. "/common",
+			"../SmoothCam/include",
+			"../Deps/glm",
+			"../Deps/eternal/include",
+			"../Deps/json/single_include",
+		}
+
+		filter "system:windows"
+			systemversion "latest"
+			characterset "Unicode"
+
+		-- Same rules as the plugin, the kernels are built without the pch for their own instruction set
+		filter( "files:".. kernels.. "*.cpp" )
+			removeforceincludes { "pch.h" }
+
+		filter( "files:".. kernels.. "avx.cpp" )
+			vectorextensions "AVX"
+
+		filter( "files:".. kernels.. "avx2.cpp" )
+			vectorextensions "AVX2"
+
+		-- msvc turns on FMA with AVX2, gcc and clang need asking
+		filter { "files:".. kernels.. "avx2.cpp", "toolset:not msc*" }
+			buildoptions { "-mfma" }
+
+		filter "configurations:Debug"
+			defines { "DEBUG" }
+			symbols "On"
+
+		filter "configurations:Release"
+			defines { "NDEBUG" }
+			optimize "Speed"
+
+		filter {}
+end
+
+mathProject "SmoothCamBench"
+	files { loc.. "/bench/**.cpp" }
+
+mathProject "SmoothCamTests"
+	files {
+		loc.. "/unit/**.cpp",
+		loc.. "/fixtures/**.inl",
+		"../SmoothCam/include/line_packing.h",
+		"../SmoothCam/source/line_packing.cpp",
+	}
\ No newline at end of file
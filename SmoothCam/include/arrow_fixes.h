@@ -1,6 +1,7 @@
 #pragma once
 
 namespace ArrowFixes {
+	// @Note: Reversed from how the spawn function reads it and not verified, only passed through to the engine
 	struct LaunchData {
 		void* vtbl;
 		NiPoint3 unkVec1;
@@ -24,5 +25,7 @@ namespace ArrowFixes {
 	bool Attach();
 #ifdef _DEBUG
 	void Draw();
+	// Writes every recorded trajectory to path as csv, one row per trace segment
+	bool ExportTraces(const wchar_t* path);
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+#include "mpsc_ring.h"
+
+// Logging that doesn't stall the calling thread
+// Arguments are captured unformatted into a lock-free queue, a background thread formats them and
+// writes them to the log. Each call site is limited to a few lines per second, the rest are counted
+// and never reach the queue.
+// Once Start has run the writer thread is the only one allowed to touch gLog, so log through these
+// and call AsyncLog::Flush before exiting or breaking into the debugger.
+#define ASYNC_LOG(level, ...)											\
+	do {																\
+		static AsyncLog::CallSite asyncLogSite_ = { __FILE__, __LINE__ };	\
+		AsyncLog::Log(level, asyncLogSite_, __VA_ARGS__);				\
+	} while (0)
+
+#define LOG_ERROR(...)		ASYNC_LOG(AsyncLog::Level::Error, __VA_ARGS__)
+#define LOG_WARNING(...)	ASYNC_LOG(AsyncLog::Level::Warning, __VA_ARGS__)
+#define LOG_MESSAGE(...)	ASYNC_LOG(AsyncLog::Level::Message, __VA_ARGS__)
+// Only logged while debug logging is enabled in the config
+#define LOG_DEBUG(...)												\
+	do {																\
+		if (AsyncLog::DebugEnabled())									\
+			ASYNC_LOG(AsyncLog::Level::Debug, __VA_ARGS__);				\
+	} while (0)
+
+namespace AsyncLog {
+	enum class Level : uint8_t {
+		Debug,
+		Message,
+		Warning,
+		Error,
+	};
+
+	// One per log statement, the counters are shared by every thread logging from it
+	typedef struct callSite {
+		const char* file = nullptr;
+		int line = 0;
+		// Start of the current one second window, in ticks
+		std::atomic<int64_t> windowStart = 0;
+		std::atomic<uint32_t> windowCount = 0;
+		// Lines turned away, reported by the line that opens the next window
+		std::atomic<uint32_t> suppressed = 0;
+	} CallSite;
+
+	// Most arguments a single line can take, extras are ignored
+	constexpr size_t maxArgs = 8;
+	// Room for copies of string arguments, longer strings are cut short
+	constexpr size_t maxText = 160;
+
+	enum class ArgType : uint8_t {
+		Int,
+		UInt,
+		Double,
+		String,
+		Pointer,
+	};
+
+	typedef struct arg {
+		ArgType type;
+		union {
+			int64_t i;
+			uint64_t u;
+			double d;
+			// Offset of the string in Entry::text
+			uint16_t text;
+			const void* p;
+		};
+	} Arg;
+
+	// A log line waiting to be formatted
+	typedef struct entry {
+		CallSite* site;
+		// Must outlive the entry - a string literal
+		const char* format;
+		int64_t ticks;
+		uint32_t threadId;
+		// Lines from this site turned away before this one
+		uint32_t suppressed;
+		Level level;
+		uint8_t argCount;
+		uint16_t textUsed;
+		Arg args[maxArgs];
+		char text[maxText];
+	} Entry;
+
+	// Starts the writer thread, lines logged before this are held until it runs
+	void Start();
+	// Returns true if LOG_DEBUG lines should be logged
+	bool DebugEnabled() noexcept;
+	void SetDebugEnabled(bool enabled) noexcept;
+
+	// Blocks until every line queued before the call has been written, or a second has passed
+	void Flush() noexcept;
+
+	// Returns false if the call site has used up its lines for this second
+	// The first line of a new window also collects the count of lines turned away before it
+	bool Admit(CallSite& site, int64_t ticks, uint32_t& suppressed) noexcept;
+	// Queues a captured line, drops it if the writer has fallen behind
+	void Submit(const Entry& entry) noexcept;
+	int64_t Ticks() noexcept;
+
+	namespace Detail {
+		template<typename T>
+		struct unsupported : std::false_type {};
+
+		void CaptureText(Entry& entry, Arg& arg, const char* str) noexcept;
+
+		template<typename T>
+		void Capture(Entry& entry, const T& value) noexcept {
+			using Type = std::decay_t<T>;
+			if (entry.argCount == maxArgs) return;
+			auto& arg = entry.args[entry.argCount++];
+
+			if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+				CaptureText(entry, arg, value);
+			} else if constexpr (std::is_enum_v<Type>) {
+				arg.type = ArgType::Int;
+				arg.i = static_cast<int64_t>(value);
+			} else if constexpr (std::is_floating_point_v<Type>) {
+				arg.type = ArgType::Double;
+				arg.d = static_cast<double>(value);
+			} else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+				arg.type = ArgType::Int;
+				arg.i = static_cast<int64_t>(value);
+			} else if constexpr (std::is_integral_v<Type>) {
+				arg.type = ArgType::UInt;
+				arg.u = static_cast<uint64_t>(value);
+			} else if constexpr (std::is_pointer_v<Type>) {
+				arg.type = ArgType::Pointer;
+				arg.p = value;
+			} else {
+				static_assert(unsupported<Type>::value, "Only numbers, enums, pointers and C strings can be logged asynchronously");
+			}
+		}
+	}
+
+	// Captures a printf style line to be formatted on the writer thread
+	template<typename... Args>
+	void Log(Level level, CallSite& site, const char* format, const Args&... args) noexcept {
+		// Turn away a noisy site before paying for the capture and the queue
+		const auto ticks = Ticks();
+		uint32_t suppressed = 0;
+		if (!Admit(site, ticks, suppressed)) return;
+
+		Entry entry;
+		entry.site = &site;
+		entry.format = format;
+		entry.ticks = ticks;
+		entry.suppressed = suppressed;
+		entry.threadId = GetCurrentThreadId();
+		entry.level = level;
+		entry.argCount = 0;
+		entry.textUsed = 0;
+		(Detail::Capture(entry, args), ...);
+		Submit(entry);
+	}
+}
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "camera_states/thirdperson.h"
 #include "camera_states/thirdperson_combat.h"
 #include "camera_states/thirdperson_horse.h"
+#include "spsc_ring.h"
+#include "transition_pool.h"
+#include "flight_recorder.h"
 
 namespace Camera {
 	typedef void(*UpdateWorldToScreenMtx)(NiCamera*);
@@ -27,14 +30,168 @@ namespace Camera {
 		FirstPersonHorseback,	// A special mode for improved camera with custom transition rules
 		FirstPersonDragon,		// A special mode for improved camera with custom transition rules
 		Unknown,				// State is not known
+		MAX_STATE,
 	};
 
+	// Describes what the player currently has drawn
+	// Used for selecting camera offsets
+	enum class WeaponStance {
+		Unarmed,				// No weapon drawn
+		Melee,					// Melee weapon drawn
+		Magic,					// Magic drawn
+		Ranged,					// Ranged weapon drawn
+		BowDrawn,				// Ranged weapon drawn with an arrow nocked
+		MAX_STANCE,
+	};
+
+	// A camera offset resolved from the user config for one action state & weapon stance pair
+	typedef struct resolvedOffset {
+		// { side, zoom, up } - Side is stored for the right shoulder, shoulder swap is applied on lookup
+		glm::vec3 offset = { 0.0f, 0.0f, 0.0f };
+		bool interp = true;
+	} ResolvedOffset;
+
+	using OffsetTable = std::array<
+		std::array<
+			std::array<ResolvedOffset, 2>, // Not on horseback, horseback
+			static_cast<size_t>(WeaponStance::MAX_STANCE)
+		>,
+		static_cast<size_t>(CameraActionState::MAX_STATE)
+	>;
+
 	enum class ScalarSelector {
 		Normal,
 		SepZ,
 		LocalSpace,
 	};
 
+	// Values that ease between states instead of snapping
+	enum class TransitionChannel {
+		Side,					// Offset to the side of the player
+		Up,						// Offset above the player
+		Zoom,					// Distance behind the player
+		MAX_CHANNEL,
+	};
+
+	// Fixed-step simulation state
+	typedef struct fixedStepState {
+		// Time not yet simulated
+		double accumulator = 0.0;
+		// The time the running step covers
+		double stepDelta = 0.0;
+		// The last two simulated positions, relative to the camera target
+		glm::vec3 lastPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 position = { 0.0f, 0.0f, 0.0f };
+		// The local offsets handed to the game by the last two steps
+		glm::vec3 lastLocalOffset = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 localOffset = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 appliedLocalOffset = { 0.0f, 0.0f, 0.0f };
+		// True while a state is running a step
+		bool stepping = false;
+		// True if a step ran this frame
+		bool stepped = false;
+		bool valid = false;
+	} FixedStepState;
+
+	// Everything the camera reads and writes each frame while simulating
+	// Holds no pointers, so a copy of it is a complete snapshot - SmoothCamera owns it and hands it to the states by reference
+	typedef struct alignas(64) simulationState {
+		glm::vec3 gameInitialWorldPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 gameLastActualPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 lastPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 currentPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 lastLocalPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 lastWorldPosition = { 0.0f, 0.0f, 0.0f };
+		// Velocity of the follow spring, in world space
+		glm::vec4 springVelocity = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		glm::vec2 currentRotation = { 0.0f, 0.0f };
+		glm::quat currentQuat = glm::identity<glm::quat>();
+		mmath::CameraBasis currentBasis;
+
+		// The camera offset after transitions
+		glm::vec3 offsetPosition = { 0.0f, 0.0f, 0.0f };
+		// Offset and zoom changes ease in through these
+		TransitionPool<static_cast<size_t>(TransitionChannel::MAX_CHANNEL)> transitions;
+
+		FixedStepState fixedStep;
+	} SimulationState;
+	static_assert(std::is_trivially_copyable<SimulationState>::value, "SimulationState must stay trivially copyable");
+	static_assert(std::is_standard_layout<SimulationState>::value, "SimulationState must stay standard layout");
+	static_assert(std::is_trivially_copyable<decltype(SimulationState::transitions)>::value,
+		"TransitionPool must stay trivially copyable");
+	static_assert(std::is_standard_layout<decltype(SimulationState::transitions)>::value,
+		"TransitionPool must stay standard layout");
+
+	// Most chords a ballistic aim path is split into, and how far any of them may stray from the arc
+	// Every chord is a separate engine cast, long lobbed shots give up on the sag limit instead
+	constexpr size_t maxAimSegments = 6;
+	constexpr float maxAimSag = 4.0f;
+
+	// Input events, pushed by the input handler and applied at the start of each camera update
+	enum class InputControl : uint8_t {
+		TogglePOV,
+		Key,
+	};
+
+	typedef struct inputRecord {
+		InputControl control;
+		uint32_t keyMask;
+		float timer;
+	} InputRecord;
+
+	// Crosshair, offset lookup, input and flight recorder data - touched at most a few times a frame
+	// Lives in its own allocation so it stays out of the cache lines the simulation runs on
+	typedef struct coldState {
+		OffsetTable offsetTable;
+		uint32_t offsetTableRevision = 0;
+
+		// Rebuilt with each camera move, the crosshair is projected through it
+		mmath::NiMatrix44 worldToScreen = {};
+
+		SPSCRing<InputRecord, 64> inputQueue;
+		// Drops already logged, the ring only keeps a running total
+		uint32_t inputDropsReported = 0;
+
+		bool povIsThird = false;
+		bool povWasPressed = false;
+		bool dialogMenuOpen = false;
+
+		// The last aim ray cast for the 3D crosshair
+		struct {
+			Raycast::RayResult result;
+			glm::vec3 origin = { 0.0f, 0.0f, 0.0f };
+			glm::vec3 direction = { 0.0f, 1.0f, 0.0f };
+			float length = 6000.0f;
+			double castTime = 0.0;
+			bool valid = false;
+			// The arc followed by the last ballistic cast, empty when the ray was straight
+			std::array<glm::vec3, maxAimSegments + 1> path;
+			size_t pathPoints = 0;
+			// The character the last cast hit, looked up again each frame to see if it moved
+			UInt32 hitCharacterHandle = 0;
+			glm::vec3 hitCharacterPos = { 0.0f, 0.0f, 0.0f };
+		} aimRay;
+
+		struct {
+			bool captured = false;
+			double xOff = 0.0;
+			double yOff = 0.0;
+			double xScale = 0.0;
+			double yScale = 0.0;
+			double xCenter = 0.0;
+			double yCenter = 0.0;
+		} baseCrosshairData;
+
+		// The flight recorder entry for the frame being updated
+		struct {
+			FlightRecorder::FrameRecord record = {};
+			int64_t frameStart = 0;
+			int64_t zoneStart = 0;
+			bool active = false;
+		} trace;
+	} ColdState;
+
 	const auto UNIT_FORWARD = glm::vec3(1.0f, 0.0f, 0.0f);
 	const auto UNIT_RIGHT = glm::vec3(0.0f, 1.0f, 0.0f);
 	const auto UNIT_UP = glm::vec3(0.0f, 0.0f, 1.0f);
@@ -67,8 +224,18 @@ namespace Camera {
 			void SetPosition(const glm::vec3& pos, const CorrectedPlayerCamera* camera) noexcept;
 
 		private:
-			void UpdateInternalWorldToScreenMatrix(NiCamera* camera, float pitch, float yaw) noexcept;
+			void UpdateInternalWorldToScreenMatrix(NiCamera* camera, const mmath::CameraBasis& basis) noexcept;
+
+			/// Flight recorder
+			// Starts or stops the recorder to match the config, and begins a record if it is running
+			void BeginFrameTrace() noexcept;
+			// Times the zone since the last one ended
+			void EndTraceZone(FlightRecorder::Zone zone) noexcept;
+			// Fills in the rest of the record and queues it
+			void EndFrameTrace(GameState::CameraState state, CameraActionState actionState, WeaponStance stance) noexcept;
 
+			// Applies the input queued since the last frame
+			void ProcessInputQueue() noexcept;
 			// Updates our POV state to the true value the game expects for each state
 			const bool UpdateCameraPOVState(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) noexcept;
 
@@ -96,34 +263,35 @@ namespace Camera {
 			float GetCurrentCameraZoom(const CorrectedPlayerCamera* camera, const GameState::CameraState currentState) const noexcept;
 			// Returns an offset group for the current player movement state
 			const Config::OffsetGroup* GetOffsetForState(const CameraActionState state) const noexcept;
-			// 
-			float GetActiveWeaponStateZoomOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept;
-			// Selects the right offset from an offset group for the player's weapon state
-			float GetActiveWeaponStateUpOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept;
-			// Selects the right offset from an offset group for the player's weapon state
-			float GetActiveWeaponStateSideOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept;
-			//
-			float GetCurrentCameraZoomOffset(PlayerCharacter* player) const noexcept;
-			// Returns the camera height for the current player state
-			float GetCurrentCameraHeight(PlayerCharacter* player) const noexcept;
+			// Resolves the offset and interp flag for the given states from the user config
+			ResolvedOffset ResolveOffset(const CameraActionState state, const WeaponStance stance, bool horseback) const noexcept;
+			// Rebuilds the resolved offset table, call when the user config changes
+			void RebuildOffsetTable() noexcept;
+			// Returns the current weapon stance of the player
+			const WeaponStance GetCurrentWeaponStance(PlayerCharacter* player) const noexcept;
 			// Returns the ideal camera distance for the current zoom level
 			float GetCurrentCameraDistance(const CorrectedPlayerCamera* camera) const noexcept;
-			// Returns the camera side offset for the current player state
-			float GetCurrentCameraSideOffset(PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept;
 			// Returns the full local-space camera offset for the current player state
-			glm::vec3 GetCurrentCameraOffset(PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept;
+			glm::vec3 GetCurrentCameraOffset(const CorrectedPlayerCamera* camera) const noexcept;
+			// Runs a camera state, at a fixed rate when fixed-step simulation is enabled
+			void RunCameraState(State::BaseCameraState* state, PlayerCharacter* player, CorrectedPlayerCamera* camera);
+			// Returns the time step the camera model is advancing by
+			static double GetSimulationDelta(const SimulationState& sim) noexcept;
 			// Returns the current smoothing scalar to use for the given distance to the player
-			double GetCurrentSmoothingScalar(const float distance, ScalarSelector method = ScalarSelector::Normal) const;
+			double GetCurrentSmoothingScalar(const SimulationState& sim, const float distance,
+				ScalarSelector method = ScalarSelector::Normal) const;
 			// Returns the user defined distance clamping vector pair
 			std::tuple<glm::vec3, glm::vec3> GetDistanceClamping() const noexcept;
 			// Returns true if interpolation is allowed in the current state
-			bool IsInterpAllowed(PlayerCharacter* player) const noexcept;
-			// Constructs the view matrix for the camera
-			glm::mat4 GetViewMatrix(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept;
+			bool IsInterpAllowed() const noexcept;
 
 			/// Crosshair stuff
 			// Updates the screen position of the crosshair for correct aiming
 			void UpdateCrosshairPosition(PlayerCharacter* player, const CorrectedPlayerCamera* camera);
+			// Returns how far the aim ray should reach for the drawn bow, crossbow or spell
+			float GetAimRayLength(const BGSProjectile* projectile, bool followArc) const noexcept;
+			// Returns true if the cached aim ray is stale and needs to be cast again
+			bool ShouldRecastAimRay(const glm::vec3& origin, const glm::vec3& direction, double curTime) const noexcept;
 			// Read initial values for the crosshair during startup
 			void ReadInitialCrosshairInfo();
 			// Set the 3D crosshair position
@@ -145,54 +313,12 @@ namespace Camera {
 			// Returns the camera's current zoom level - Camera must extend ThirdPersonState
 			float GetCameraZoomScalar(const CorrectedPlayerCamera* camera, uint16_t cameraState) const noexcept;
 
-			// Run a transition state
-			template<typename T, typename S>
-			void UpdateTransitionState(double curTime, bool enabled, float duration, Config::ScalarMethods method,
-				S& transitionState, const T& currentValue)
-			{
-				// Check our current offset and see if we need to run a transition 
-				if (enabled) {
-					if (currentValue != transitionState.targetPosition) {
-						// Start the task
-						if (transitionState.running)
-							transitionState.lastPosition = transitionState.currentPosition;
-
-						transitionState.running = true;
-						transitionState.startTime = curTime;
-						transitionState.targetPosition = currentValue;
-					}
-
-					if (transitionState.running) {
-						// Update the transition smoothing
-						const auto scalar = glm::clamp(
-							static_cast<float>(curTime - transitionState.startTime) / glm::max(duration, 0.01f),
-							0.0f, 1.0f
-						);
-
-						if (scalar < 1.0f) {
-							transitionState.currentPosition = mmath::Interpolate<T, float>(
-								transitionState.lastPosition,
-								transitionState.targetPosition,
-								mmath::RunScalarFunction<float>(method, scalar)
-							);
-						} else {
-							transitionState.currentPosition = transitionState.targetPosition;
-							transitionState.running = false;
-							transitionState.lastPosition = transitionState.currentPosition;
-						}
-					} else {
-						transitionState.lastPosition = transitionState.targetPosition =
-							transitionState.currentPosition = currentValue;
-					}
-				} else {
-					// Disabled
-					transitionState.running = false;
-					transitionState.lastPosition = transitionState.targetPosition =
-						transitionState.currentPosition = currentValue;
-				}
-			}
-			
 		private:
+			// Read and written by every camera update, kept first and on its own cache lines
+			SimulationState sim;
+
+			// Everything below is bookkeeping, UI and input state
+			std::unique_ptr<ColdState> cold;
 			std::array<std::unique_ptr<State::BaseCameraState>, static_cast<size_t>(GameState::CameraState::MAX_STATE)> cameraStates;
 
 			Config::UserConfig* config = nullptr;
@@ -200,54 +326,17 @@ namespace Camera {
 			GameState::CameraState lastState = GameState::CameraState::Unknown;
 			CameraActionState currentActionState = CameraActionState::Unknown;
 			CameraActionState lastActionState = CameraActionState::Unknown;
-			mmath::NiMatrix44 worldToScreen = {};
 
 			float lastNearPlane = 0.0f;
-			glm::vec3 gameInitialWorldPosition = { 0.0f, 0.0f, 0.0f };
-			glm::vec3 gameLastActualPosition = { 0.0f, 0.0f, 0.0f };
-			glm::vec3 lastPosition = { 0.0f, 0.0f, 0.0f };
-			glm::vec3 currentPosition = { 0.0f, 0.0f, 0.0f };
-			glm::vec3 lastLocalPosition = { 0.0f, 0.0f, 0.0f };
-			glm::vec3 lastWorldPosition = { 0.0f, 0.0f, 0.0f };
-
-			glm::vec2 currentRotation = { 0.0f, 0.0f };
-			glm::quat currentQuat = glm::identity<glm::quat>();
-
-			template<typename T>
-			struct TransitionGroup {
-				T lastPosition = {};
-				T targetPosition = {};
-				T currentPosition = {};
-				bool running = false;
-				double startTime = 0.0;
-			};
-
-			using OffsetTransition = TransitionGroup<glm::vec2>;
-			using ZoomTransition = TransitionGroup<float>;
-			OffsetTransition offsetTransitionState;
-			ZoomTransition zoomTransitionState;
 
 			struct {
-				const Config::OffsetGroup* currentGroup = nullptr;
-				glm::vec3 position = { 0.0f, 0.0f, 0.0f };
+				const ResolvedOffset* current = nullptr;
 			} offsetState;
 
-			struct {
-				bool captured = false;
-				double xOff = 0.0;
-				double yOff = 0.0;
-				double xScale = 0.0;
-				double yScale = 0.0;
-				double xCenter = 0.0;
-				double yCenter = 0.0;
-			} baseCrosshairData;
-
 			bool firstFrame = false;
-			bool povIsThird = false;
-			bool povWasPressed = false;
-			bool dialogMenuOpen = false;
 			int shoulderSwap = 1;
 
+			// For the crosshair, config and flight recorder - the simulation state is passed to the states instead
 			friend class State::BaseCameraState;
 	};
 }
\ No newline at end of file
@@ -5,6 +5,8 @@ namespace Camera {
 	class SmoothCamera;
 	enum class CameraState;
 	enum class CameraActionState;
+	struct simulationState;
+	typedef struct simulationState SimulationState;
 
 	namespace State {
 		/* The base camera state - exposes higher level methods for operating on the camera */
@@ -20,7 +22,11 @@ namespace Camera {
 				virtual ~BaseCameraState();
 				virtual void OnBegin(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) = 0;
 				virtual void OnEnd(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) = 0;
-				virtual void Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera) = 0;
+				// Runs the camera model, reading and writing the simulation state it is given
+				virtual void Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera, SimulationState& sim) = 0;
+				// Places the camera at a position blended between fixed-step updates, without running the camera model
+				void Present(PlayerCharacter* player, const CorrectedPlayerCamera* camera, SimulationState& sim,
+					const glm::vec3& pos, const glm::vec3& localPos);
 
 			protected:
 				// Returns the current camera state
@@ -29,7 +35,7 @@ namespace Camera {
 				Camera::CameraActionState GetCameraActionState() const noexcept;
 
 				// Returns the position of the camera during the last frame
-				glm::vec3 GetLastCameraPosition() const noexcept;
+				glm::vec3 GetLastCameraPosition(const SimulationState& sim) const noexcept;
 				// Sets the camera position
 				void SetCameraPosition(const glm::vec3& pos, const CorrectedPlayerCamera* playerCamera) noexcept;
 				// Performs a ray cast and returns a new position based on the result
@@ -43,7 +49,7 @@ namespace Camera {
 					PlayerCharacter* player, const glm::vec3& cameraWorldTarget,
 					const glm::vec3& cameraPosition) const;
 
-				void UpdateCrosshair(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const;
+				void UpdateCrosshair(const SimulationState& sim, PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const;
 				// Updates the 3D crosshair position, performing all logic internally
 				void UpdateCrosshairPosition(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const;
 				// Directly sets the crosshair position
@@ -53,26 +59,27 @@ namespace Camera {
 				// Toggles visibility of the crosshair
 				void SetCrosshairEnabled(bool enabled) const;
 
-				// Returns a rotation matrix to use with rotating the camera
-				glm::mat4 GetViewMatrix(const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const noexcept;
+				// Returns the camera basis computed for this frame
+				const mmath::CameraBasis& GetCameraBasis(const SimulationState& sim) const noexcept;
 				// Returns the euler rotation of the camera
-				glm::vec2 GetCameraRotation(const CorrectedPlayerCamera* playerCamera) const noexcept;
+				glm::vec2 GetCameraRotation(const SimulationState& sim) const noexcept;
 				// Returns the local offsets to apply to the camera
-				glm::vec3 GetCameraLocalPosition(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const noexcept;
+				glm::vec3 GetCameraLocalPosition(const SimulationState& sim) const noexcept;
 				// Returns the world position to apply local offsets to
 				glm::vec3 GetCameraWorldPosition(const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const;
 				// Performs all camera offset math using the view rotation matrix and local offsets, returns a local position
-				glm::vec3 GetTransformedCameraLocalPosition(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const;
+				glm::vec3 GetTransformedCameraLocalPosition(const SimulationState& sim, const mmath::CameraBasis& basis) const;
 				// Interpolates the given position, stores last interpolated rotation
-				glm::vec3 UpdateInterpolatedLocalPosition(PlayerCharacter* player, const glm::vec3& rot);
+				glm::vec3 UpdateInterpolatedLocalPosition(SimulationState& sim, const glm::vec3& rot);
 				// Interpolates the given position, stores last interpolated position
-				glm::vec3 UpdateInterpolatedWorldPosition(PlayerCharacter* player, const glm::vec3& pos, const float distance);
+				glm::vec3 UpdateInterpolatedWorldPosition(SimulationState& sim, const glm::vec3& pos, const float distance);
 
-				void ApplyLocalSpaceGameOffsets(const glm::vec3& pos, const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera);
-				void StoreLastLocalPosition(const glm::vec3& pos);
-				void StoreLastWorldPosition(const glm::vec3& pos);
-				glm::vec3 GetLastLocalPosition();
-				glm::vec3 GetLastWorldPosition();
+				void ApplyLocalSpaceGameOffsets(SimulationState& sim, const glm::vec3& pos, const mmath::CameraBasis& basis,
+					const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera);
+				void StoreLastLocalPosition(SimulationState& sim, const glm::vec3& pos);
+				void StoreLastWorldPosition(SimulationState& sim, const glm::vec3& pos);
+				glm::vec3 GetLastLocalPosition(const SimulationState& sim) const noexcept;
+				glm::vec3 GetLastWorldPosition(const SimulationState& sim) const noexcept;
 
 				// Returns true if the player is moving
 				bool IsPlayerMoving(const PlayerCharacter* player) const noexcept;
@@ -14,7 +14,7 @@ namespace Camera {
 			public:
 				virtual void OnBegin(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) override;
 				virtual void OnEnd(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) override;
-				virtual void Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera) override;
+				virtual void Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera, SimulationState& sim) override;
 		};
 	}
 }
\ No newline at end of file
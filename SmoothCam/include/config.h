@@ -121,9 +121,23 @@ namespace Config {
 		float crosshairNPCHitGrowSize = 16.0f;
 		float crosshairMinDistSize = 16.0f;
 		float crosshairMaxDistSize = 24.0f;
+		// Longest time in seconds to reuse the last aim ray while aim is held steady, 0 casts every frame
+		float crosshairRayMaxInterval = 0.1f;
+		// Upper bound on the aim ray length, in game units
+		float crosshairRayMaxLength = 6000.0f;
+		// Follow the arc arrows and bolts actually fly instead of casting a straight line
+		bool crosshairBallisticAim = false;
 
 		// Misc
 		bool disableDeltaTime = false;
+		// Run the camera model at a fixed rate, presenting in-between positions on the frames in between
+		bool fixedStepSimulation = false;
+		// Steps per second when fixedStepSimulation is on
+		float fixedStepRate = 60.0f;
+		// Write a trace of every camera update to the SKSE log folder
+		bool enableFlightRecorder = false;
+		// Log diagnostic traces from the camera update, written in the background
+		bool enableDebugLogging = false;
 		int shoulderSwapKey = -1;
 		bool swapXClamping = true;
 		
@@ -148,6 +162,12 @@ namespace Config {
 		ScalarMethods separateLocalScalar = ScalarMethods::EXP_IN;
 		float localScalarRate = 1.0f;
 
+		// Critically damped spring, replaces the follow rates and separate Z when enabled
+		bool springInterp = false;
+		// Roughly the time in seconds the spring takes to catch up to the player
+		float springSmoothTimeXY = 0.3f;
+		float springSmoothTimeZ = 0.2f;
+
 		// Separate Z
 		bool separateZInterp = true;
 		ScalarMethods separateZScalar = ScalarMethods::SINE_IN;
@@ -201,6 +221,8 @@ namespace Config {
 	void ReadConfigFile();
 	void SaveCurrentConfig();
 	UserConfig* GetCurrentConfig() noexcept;
+	// Returns a counter which is incremented each time the user config changes
+	uint32_t GetConfigRevision() noexcept;
 	void ResetConfig();
 
 	// Returns "" if ok, otherwise has an error message
@@ -1,15 +1,43 @@
 #pragma once
 #include <d3d11.h>
+#include "line_packing.h"
 
 namespace DebugDrawing {
 	class Shader;
-	class Command;
+
+	enum class CommandType : uint8_t {
+		None,
+		DrawLine,
+		DrawBox
+	};
+
+	// Precedes every command written to the arena
+	typedef struct {
+		CommandType type;
+		// Bytes until the next record, including this header - 0 marks the end of a full buffer
+		uint32_t stride;
+	} CommandHeader;
+
+	// Commands are written to one buffer while Present draws the other, then the two swap
+	// Records are bump allocated from an atomic head, so submitting never locks or allocates
+	typedef struct commandBuffer {
+		static constexpr size_t Capacity = 256 * 1024;
+
+		alignas(16) uint8_t data[Capacity];
+		std::atomic<size_t> head = 0;
+		// Submits currently writing into this buffer
+		std::atomic<uint32_t> writers = 0;
+		// Records that didn't fit and were dropped
+		std::atomic<uint32_t> dropped = 0;
+	} CommandBuffer;
 
 	typedef struct {
-		std::mutex lock;
-		std::vector<std::unique_ptr<DebugDrawing::Command>> queue;
-	} CommandQueue;
-	CommandQueue* GetCommandQueue();
+		CommandBuffer buffers[2];
+		std::atomic<uint32_t> writeIndex = 0;
+	} CommandArena;
+	CommandArena* GetCommandArena();
+	// Copies a command into the current write buffer, returning false if it was full
+	bool WriteCommand(CommandType type, const void* cmd, size_t size);
 	bool DrawingEnabled();
 	void SetDrawingEnabled(bool enable);
 
@@ -24,26 +52,16 @@ namespace DebugDrawing {
 	bool CreateTempResources();
 	void DetourD3D11();
 
-	enum class CommandType : uint8_t {
-		None,
-		DrawLine,
-		DrawBox
-	};
-
-	class Command {
-		public:
-			CommandType type = CommandType::None;
-	};
-
 	struct LineVertex {
 		glm::vec2 point;
 		glm::vec3 color;
 	};
 
-	class DrawLine : public Command {
+	class DrawLine {
 		public:
+			static constexpr CommandType Type = CommandType::DrawLine;
+
 			DrawLine(const glm::vec2& start, const glm::vec2& end, const glm::vec3& color = { 1.0f, 0.0f, 0.0f }) {
-				type = CommandType::DrawLine;
 				this->start.point = start;
 				this->start.color = color;
 				this->end.point = end;
@@ -54,14 +72,15 @@ namespace DebugDrawing {
 			LineVertex start;
 			LineVertex end;
 
-		friend class LineDrawer;
+		friend class LineBatcher;
 	};
 
-	class DrawBox : public Command {
+	class DrawBox {
 		public:
-			using BoxPoints = std::array<glm::vec2, 8>;
-			DrawBox(BoxPoints& lines, const glm::vec3& color = { 1.0f, 0.0f, 0.0f }) {
-				type = CommandType::DrawBox;
+			static constexpr CommandType Type = CommandType::DrawBox;
+			using BoxPoints = BoxCorners;
+
+			DrawBox(const BoxPoints& lines, const glm::vec3& color = { 1.0f, 0.0f, 0.0f }) {
 				box = lines;
 				this->color = color;
 			}
@@ -70,50 +89,41 @@ namespace DebugDrawing {
 			BoxPoints box;
 			glm::vec3 color;
 
-		friend class BoxDrawer;
+		friend class LineBatcher;
 	};
 
 	template<typename T>
-	void Submit(T& cmd) {
-		static_assert(std::is_base_of<DebugDrawing::Command, T>(), "Argument does not extend from DebugDrawing::Command");
+	void Submit(const T& cmd) {
+		static_assert(std::is_trivially_copyable<T>(), "Commands are copied into the arena as raw bytes");
+		static_assert(T::Type != CommandType::None, "Argument is not a DebugDrawing command");
 		if (!DebugDrawing::DrawingEnabled()) return;
 
-		auto commandQueue = DebugDrawing::GetCommandQueue();
-		// Guarding a vector with a mutex like this is super lazy, but this is a debug tool so whatever
-		std::lock_guard<std::mutex> lock(commandQueue->lock);
-		commandQueue->queue.push_back(std::move(std::make_unique<T>(cmd)));
+		DebugDrawing::WriteCommand(T::Type, &cmd, sizeof(T));
 	}
 
 	void Flush();
 	void CreateDrawers();
 	void CreateBuffer(size_t size, D3D11_BIND_FLAG binding, ID3D11Buffer*& buffer);
 
-	class LineDrawer {
+	// Gathers the lines and box edges of every command in a frame and draws them with a single call
+	class LineBatcher {
 		public:
-			LineDrawer(const D3DObjects& obj);
+			LineBatcher(const D3DObjects& obj);
 			bool CreateLayout(const D3DObjects& obj, ID3DBlob* shader);
 			bool CreateShaders(const D3DObjects& obj);
-			void Submit(const D3DObjects& obj, const DrawLine& cmd);
+			void Add(const DrawLine& cmd);
+			void Add(const DrawBox& cmd);
+			// Uploads and draws everything added since the last call
+			void Draw(const D3DObjects& obj);
 
 		private:
-			ID3D11InputLayout* inputLayout = nullptr;
-			ID3D11Buffer* vertexBuffer = nullptr;
-			D3D11_MAPPED_SUBRESOURCE mappedBuffer;
-			std::unique_ptr<Shader> vertexShader;
-			std::unique_ptr<Shader> pixelShader;
-	};
+			// Grows the vertex buffer so it can hold at least vertexCount vertices
+			void Reserve(size_t vertexCount);
 
-	class BoxDrawer {
-		public:
-			BoxDrawer(const D3DObjects& obj);
-			bool CreateLayout(const D3DObjects& obj, ID3DBlob* shader);
-			bool CreateShaders(const D3DObjects& obj);
-			void Submit(const D3DObjects& obj, const DrawBox& cmd);
-
-		private:
 			ID3D11InputLayout* inputLayout = nullptr;
 			ID3D11Buffer* vertexBuffer = nullptr;
-			D3D11_MAPPED_SUBRESOURCE mappedBuffer;
+			size_t vertexCapacity = 0;
+			std::vector<PackedVertex> vertices;
 			std::unique_ptr<Shader> vertexShader;
 			std::unique_ptr<Shader> pixelShader;
 	};
@@ -20,7 +20,7 @@ namespace Detours {
 				);
 
 			if (!hook.hook()) {
-				_ERROR("Failed to place detour on target virtual function, this error is fatal.");
+				LOG_ERROR("Failed to place detour on target virtual function, this error is fatal.");
 				FatalError(L"Failed to place detour on target virtual function, this error is fatal.");
 			}
 		}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of the flight recorder trace
+// Shared with the decoder in Tools/FlightDecode, so keep this free of game and plugin headers
+namespace FlightRecorder {
+	// "SCFR", little endian
+	constexpr uint32_t fileMagic = 0x52464353;
+	// Bump when FrameRecord changes
+	constexpr uint32_t fileVersion = 1;
+
+	// Written once at the start of every trace file
+	typedef struct fileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t recordSize;
+		// Ticks per second of the zone timer, for reference
+		uint32_t timerFrequency;
+	} FileHeader;
+
+	// Timed sections of a camera update
+	enum class Zone : uint8_t {
+		Setup,					// Config, input and state selection
+		State,					// The camera state update
+		AimCast,				// Casting the aim ray for the 3D crosshair
+		Total,					// The whole update
+		MAX_ZONE,
+	};
+
+	enum RecordFlags : uint8_t {
+		CollisionHit		= 1 << 0,	// The camera collision ray hit something
+		AimHit				= 1 << 1,	// The aim ray hit something
+		AimHitCharacter		= 1 << 2,	// The aim ray hit a character
+		AimRecast			= 1 << 3,	// The aim ray was cast this frame rather than reused
+		FixedStep			= 1 << 4,	// A fixed simulation step ran this frame
+		DialogOpen			= 1 << 5,	// The dialogue menu was open
+	};
+
+	// One camera update
+	typedef struct frameRecord {
+		// Counts every update while the recorder runs, gaps mean records were dropped
+		uint64_t frame;
+		// Game timer, in seconds
+		double time;
+		float frameDelta;
+		uint8_t cameraState;
+		uint8_t actionState;
+		uint8_t weaponStance;
+		uint8_t flags;
+		// World space position the camera follows
+		float target[3];
+		// Camera position before and after the collision ray, world space
+		float preClamp[3];
+		float postClamp[3];
+		// Final camera position for the frame
+		float position[3];
+		// Length of the collision ray to the hit, or the full ray if nothing was hit
+		float rayLength;
+		// Crosshair position in screen space
+		float crosshair[2];
+		// Records dropped so far because the writer fell behind
+		uint32_t dropped;
+		// Time spent in each zone, in microseconds
+		float zoneMicros[static_cast<size_t>(Zone::MAX_ZONE)];
+	} FrameRecord;
+	static_assert(sizeof(FrameRecord) == 104, "FrameRecord layout changed, bump fileVersion");
+}
\ No newline at end of file
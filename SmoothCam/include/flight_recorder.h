@@ -0,0 +1,30 @@
+#pragma once
+#include "flight_record.h"
+
+// Optional per-frame trace of the camera, for looking into stutter reports
+// The game thread queues one record per camera update, a background thread writes them to
+// SmoothCam_Trace.bin in the SKSE log folder, rolling over to SmoothCam_Trace.prev.bin
+namespace FlightRecorder {
+	// Opens the trace file and starts the writer thread
+	// Returns false if the file couldn't be opened
+	bool Start();
+	// Writes out anything still queued and stops the writer thread
+	void Stop();
+	// Returns true while the writer thread is running
+	bool IsRunning() noexcept;
+
+	// Game thread only - numbers and queues a record, it is dropped if the writer has fallen behind
+	void Submit(FrameRecord& record) noexcept;
+
+	// Returns a timestamp for zone timings
+	int64_t Ticks() noexcept;
+	// Converts a span of ticks to microseconds
+	float TicksToMicros(int64_t ticks) noexcept;
+
+	// Copies a vector into a record field
+	inline void Store(float(&out)[3], const glm::vec3& v) noexcept {
+		out[0] = v.x;
+		out[1] = v.y;
+		out[2] = v.z;
+	}
+}
\ No newline at end of file
@@ -118,6 +118,8 @@ namespace GameState {
 	const bool IsUsingCrossbow(PlayerCharacter* player) noexcept;
 	// Returns true if a bow is drawn
 	const bool IsUsingBow(PlayerCharacter* player) noexcept;
+	// Returns the projectile the player would launch with the drawn bow, crossbow or spell, or nullptr
+	const BGSProjectile* GetEquippedProjectile(PlayerCharacter* player) noexcept;
 	// Returns true if the player is sneaking
 	const bool IsSneaking(const PlayerCharacter* player) noexcept;
 	// Returns true if the player is sprinting
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace InternedNames {
+	// Every control and menu name the plugin reacts to
+	enum class Name : uint8_t {
+		TogglePOV,
+		DialogueMenu,
+		LoadingMenu,
+		MAX_NAME,
+	};
+
+	// Resolves each name against the game's string table, call once the game has loaded
+	void Initialize();
+	// Returns the interned string for name, or nullptr before Initialize
+	const char* Get(Name name) noexcept;
+	// Returns true if str is the interned string for name
+	// BSFixedStrings share one copy of each string, so this is a pointer compare
+	bool Is(const char* str, Name name) noexcept;
+}
\ No newline at end of file
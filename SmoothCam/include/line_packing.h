@@ -0,0 +1,27 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace DebugDrawing {
+	// A line list vertex, laid out to match the POS/COL input layout of the line shader
+	typedef struct {
+		glm::vec4 position;
+		glm::vec4 color;
+	} PackedVertex;
+	static_assert(sizeof(PackedVertex) == sizeof(float) * 8);
+
+	using BoxCorners = std::array<glm::vec2, 8>;
+
+	constexpr size_t lineVertexCount = 2;
+	constexpr size_t boxVertexCount = 24;
+
+	// Writes the 2 vertices of a screen space line to out, returning the number written
+	size_t PackLine(const glm::vec2& start, const glm::vec3& startColor, const glm::vec2& end,
+		const glm::vec3& endColor, PackedVertex* out) noexcept;
+
+	// Writes the 12 edges of a projected box to out as 24 vertices, returning the number written
+	// Corners are ordered bottom-left-front, bottom-right-front, bottom-left-back, bottom-right-back,
+	// then the same again for the top
+	size_t PackBox(const BoxCorners& corners, const glm::vec3& color, PackedVertex* out) noexcept;
+}
\ No newline at end of file
@@ -6,6 +6,10 @@ namespace Config {
 
 namespace mmath {
 	constexpr const float half_pi = 1.57079632679485f;
+	// The zero tolerance the game passes to WorldPtToScreenPt3
+	constexpr const float projectionZeroTolerance = 9.99999975e-06f;
+	// Havok's world gravity (9.81 m/s^2) in game units (0.0142875 m) per second squared
+	constexpr const float havokGravity = 686.6f;
 
 	typedef struct {
 		float data[4][4];
@@ -15,14 +19,14 @@ namespace mmath {
 		glm::vec3 mins;
 		glm::vec3 maxs;
 
-		aabb aabb::operator+ (const glm::vec3& rhs) {
+		aabb operator+ (const glm::vec3& rhs) {
 			return {
 				mins + rhs,
 				maxs + rhs
 			};
 		}
 
-		aabb aabb::operator+ (const NiPoint3& rhs) {
+		aabb operator+ (const NiPoint3& rhs) {
 			return {
 				mins + glm::vec3{ rhs.x, rhs.y, rhs.z },
 				maxs + glm::vec3{ rhs.x, rhs.y, rhs.z }
@@ -30,6 +34,21 @@ namespace mmath {
 		}
 	} AABB;
 
+	// Everything derived from the camera pitch and yaw, computed once per frame
+	typedef struct cameraBasis {
+		float pitch = 0.0f;
+		float yaw = 0.0f;
+		// { pitch, yaw }
+		glm::vec2 sin = { 0.0f, 0.0f };
+		glm::vec2 cos = { 1.0f, 1.0f };
+		// Columns of the view matrix
+		glm::vec3 right = { 1.0f, 0.0f, 0.0f };
+		glm::vec3 forward = { 0.0f, 1.0f, 0.0f };
+		glm::vec3 up = { 0.0f, 0.0f, 1.0f };
+		glm::mat4 view = glm::identity<glm::mat4>();
+		glm::quat quat = glm::identity<glm::quat>();
+	} CameraBasis;
+
 	bool IsInf(const float& f) noexcept;
 	bool IsInf(const glm::vec3& v) noexcept;
 	bool IsInf(const glm::vec4& v) noexcept;
@@ -42,18 +61,73 @@ namespace mmath {
 	bool IsValid(const glm::vec3& v) noexcept;
 	bool IsValid(const glm::vec4& v) noexcept;
 
+	// Computes the sine and cosine of 4 angles at once
+	void SinCos(const glm::vec4& angles, glm::vec4& sines, glm::vec4& cosines) noexcept;
 	// Return the forward view vector
 	glm::vec3 GetViewVector(const glm::vec3& forwardRefer, float pitch, float yaw) noexcept;
+	// Returns the camera rotation matrix for the given pitch and yaw
+	glm::mat4 GetViewMatrix(const float pitch, const float yaw) noexcept;
 	// Extracts pitch and yaw from a rotation matrix
 	glm::vec3 NiMatrixToEuler(const NiMatrix33& m) noexcept;
 	// Creates a rotation matrix for NiCameras to compute a proper world to screen matrix for scaleform
 	NiMatrix33 ToddHowardTransform(const float pitch, const float yaw) noexcept;
+	NiMatrix33 ToddHowardTransform(const CameraBasis& basis) noexcept;
+	// Builds the world to clip matrix the same way NiCamera does, from the camera frustum, rotation and position
+	void ComputeWorldToScreen(const NiFrustum& frustum, const NiMatrix33& rotation, const glm::vec3& position,
+		NiMatrix44& worldToScreen) noexcept;
+	// Builds the shared camera basis for the given pitch and yaw
+	CameraBasis ComputeCameraBasis(const float pitch, const float yaw) noexcept;
+	// Rotates a { side, zoom, up } camera offset by the view, the height stays world aligned
+	glm::vec3 TransformLocalOffset(const glm::vec3& local, const CameraBasis& basis) noexcept;
+	// Projects a point onto the basis vectors of the camera, returns { right, forward, up } coefficients
+	glm::vec3 DecomposeToBasis(const glm::vec3& point, const CameraBasis& basis) noexcept;
 	// Decompose a position to 3 basis vectors and the coefficients, given an euler rotation
 	void DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
 		glm::vec3& forward, glm::vec3& right, glm::vec3& up, glm::vec3& coef) noexcept;
 
+	// Scalar reference implementations of the vectorized functions above
+	// Slow - these exist to validate the results of the fast paths against
+	namespace Scalar {
+		void SinCos(const glm::vec4& angles, glm::vec4& sines, glm::vec4& cosines) noexcept;
+		glm::vec3 GetViewVector(const glm::vec3& forwardRefer, float pitch, float yaw) noexcept;
+		glm::mat4 GetViewMatrix(const float pitch, const float yaw) noexcept;
+		NiMatrix33 ToddHowardTransform(const float pitch, const float yaw) noexcept;
+		void DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
+			glm::vec3& forward, glm::vec3& right, glm::vec3& up, glm::vec3& coef) noexcept;
+		bool ProjectPoint(const NiMatrix44& worldToScreen, const NiRect<float>& port, const glm::vec3& point,
+			glm::vec3& screen, float zeroTolerance = projectionZeroTolerance) noexcept;
+		void InterpolateChannels(const float* from, const float* to, const float* scalars, size_t count,
+			float* out) noexcept;
+		// Steps a projectile through time until it falls through the plane at planeZ, returning where it crossed
+		glm::vec3 BallisticImpact(const glm::vec3& origin, const glm::vec3& velocity, float gravity, float planeZ,
+			float timeStep) noexcept;
+	}
+
+	// Projects points to the screen with a cached world to clip matrix, 4 at a time
+	// Points behind the camera are flagged as not visible
+	void ProjectPoints(const NiMatrix44& worldToScreen, const NiRect<float>& port, const glm::vec3* points, size_t count,
+		glm::vec3* screen, uint8_t* visible, float zeroTolerance = projectionZeroTolerance) noexcept;
+	// Clips a line segment to the part in front of the camera, returns false if it is entirely behind
+	bool ClipSegment(const NiMatrix44& worldToScreen, glm::vec3& start, glm::vec3& end,
+		float zeroTolerance = projectionZeroTolerance) noexcept;
 	glm::vec2 PointToScreen(const glm::vec3& point);
 
+	// Moves position towards target along a critically damped spring, carrying velocity between calls
+	// omegaXY and omegaZ are the spring frequencies for the horizontal and vertical axes, higher is stiffer
+	// This is the exact solution rather than a numeric step, so any deltaTime gives the same path
+	void CriticalSpring(glm::vec4& position, glm::vec4& velocity, const glm::vec4& target,
+		float omegaXY, float omegaZ, float deltaTime) noexcept;
+
+	// Time for a projectile launched along direction to travel range units measured along its arc
+	float BallisticFlightTime(const glm::vec3& direction, float speed, float gravity, float range) noexcept;
+
+	// Samples the arc of a projectile into chords, using more of them the longer the flight so that no chord
+	// strays more than maxSag units from the arc. The points lie exactly on the arc.
+	// range is the distance travelled along the arc, like the game's projectile range
+	// out must hold maxSegments + 1 points, returns the number of points written
+	size_t BallisticPath(const glm::vec3& origin, const glm::vec3& direction, float speed, float gravity,
+		float range, float maxSag, size_t maxSegments, glm::vec3* out) noexcept;
+
 	template<typename T, typename S>
 	T Interpolate(const T from, const T to, const S scalar) noexcept {
 		if (scalar > 1.0) return to;
@@ -61,6 +135,10 @@ namespace mmath {
 		return from + (to - from) * scalar;
 	};
 
+	// Interpolate<float, float> over count channels at once
+	void InterpolateChannels(const float* from, const float* to, const float* scalars, size_t count,
+		float* out) noexcept;
+
 	template<typename T>
 	T Remap(T value, T inMin, T inMax, T outMin, T outMax) noexcept {
 		return outMin + (((value - inMin) / (inMax - inMin)) * (outMax - outMin));
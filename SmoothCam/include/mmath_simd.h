@@ -0,0 +1,68 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized mmath, interpolation and debug vertex packing kernels, compiled once per instruction set and
+// selected at load time
+namespace mmath::SIMD {
+	enum class ISA {
+		SSE2,			// Baseline, every x64 CPU
+		AVX,			// VEX encoded SSE kernels
+		AVX2,			// VEX encoded with FMA
+		MAX_ISA,
+	};
+
+	// Sine and cosine of 4 angles
+	typedef void(*SinCosKernel)(const float* angles, float* sines, float* cosines) noexcept;
+	// Sine and cosine of { pitch, yaw } and the 3 columns of the view matrix, stored as 3 float4s
+	typedef void(*CameraBasisKernel)(float pitch, float yaw, float* sines, float* cosines, float* columns) noexcept;
+	// Euler XYZ rotation to forward, right and up vectors, stored as 3 float4s
+	typedef void(*EulerBasisKernel)(const float* rotation, float* columns) noexcept;
+	// Projects a point on to 3 basis vectors stored as float4s
+	typedef void(*ProjectKernel)(const float* point, const float* columns, float* coef) noexcept;
+	// Projects packed xyz world points to the screen with a row major world to clip matrix and a { left, right, top, bottom } viewport
+	// Matches NiCamera::WorldPtToScreenPt3 - points behind the camera get visible = 0 and a zeroed screen position
+	typedef void(*ScreenProjectKernel)(const float* worldToScreen, const float* port, const float* points, size_t count,
+		float zeroTolerance, float* screen, uint8_t* visible) noexcept;
+	// from + (to - from) * scalar for count channels, a scalar past either end returns that end like mmath::Interpolate
+	typedef void(*InterpolateKernel)(const float* from, const float* to, const float* scalars, size_t count,
+		float* out) noexcept;
+	// Writes count line list vertices as { x, y, 0, 1 } { r, g, b, 1 } from xy points and rgb colors
+	// colorStride is the number of floats between colors, 0 uses the first color for every vertex
+	typedef void(*PackVerticesKernel)(const float* points, const float* colors, size_t colorStride, size_t count,
+		float* out) noexcept;
+
+	typedef struct kernelTable {
+		SinCosKernel sinCos = nullptr;
+		CameraBasisKernel cameraBasis = nullptr;
+		EulerBasisKernel eulerBasis = nullptr;
+		ProjectKernel project = nullptr;
+		ScreenProjectKernel screenProject = nullptr;
+		InterpolateKernel interpolate = nullptr;
+		PackVerticesKernel packVertices = nullptr;
+	} KernelTable;
+
+	// Per instruction set kernel tables - only call into ones the CPU supports
+	namespace SSE2 {
+		const KernelTable* GetKernelTable() noexcept;
+	}
+	namespace AVX {
+		const KernelTable* GetKernelTable() noexcept;
+	}
+	namespace AVX2 {
+		const KernelTable* GetKernelTable() noexcept;
+	}
+
+	// Returns the best instruction set supported by the CPU and OS
+	ISA DetectISA() noexcept;
+	// Selects the best kernels for this CPU, call once during plugin load
+	void Initialize() noexcept;
+	// Forces a specific kernel table, returns false if the CPU does not support it
+	bool ForceISA(ISA isa) noexcept;
+	// Returns the instruction set of the active kernel table
+	ISA GetActiveISA() noexcept;
+	// Returns a printable name for the instruction set
+	const char* GetISAName(ISA isa) noexcept;
+	// Returns the active kernel table
+	const KernelTable& GetKernels() noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+// A fixed capacity, lock-free queue for any number of producer threads and exactly one consumer thread
+// Each slot carries a sequence number so producers can claim slots without locking
+// Capacity must be a power of two
+template<typename T, size_t Capacity>
+class MPSCRing {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static_assert(std::is_trivially_copyable<T>(), "Ring entries are copied in and out as plain values");
+
+	public:
+		MPSCRing() noexcept {
+			for (size_t i = 0; i < Capacity; i++)
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		// Any thread - returns false and counts a drop if the ring is full
+		bool Push(const T& value) noexcept {
+			auto head = writeHead.load(std::memory_order_relaxed);
+			for (;;) {
+				auto& cell = cells[head & (Capacity - 1)];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head);
+
+				if (diff == 0) {
+					// The slot is free, claim it
+					if (writeHead.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(head + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (diff < 0) {
+					// The consumer hasn't freed this slot yet
+					dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				} else {
+					// Another producer claimed it first
+					head = writeHead.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Consumer only - returns false if the ring is empty
+		bool Pop(T& value) noexcept {
+			auto& cell = cells[readHead & (Capacity - 1)];
+			if (cell.sequence.load(std::memory_order_acquire) != readHead + 1) return false;
+
+			value = cell.value;
+			cell.sequence.store(readHead + Capacity, std::memory_order_release);
+			readHead++;
+			return true;
+		}
+
+		// Returns the number of pushes rejected because the ring was full
+		uint32_t Dropped() const noexcept {
+			return dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		typedef struct cell {
+			std::atomic<size_t> sequence;
+			T value;
+		} Cell;
+
+		// Keep the two ends on separate cache lines so the threads don't fight over them
+		alignas(64) std::atomic<size_t> writeHead = 0;
+		alignas(64) size_t readHead = 0;
+		std::atomic<uint32_t> dropped = 0;
+		std::array<Cell, Capacity> cells;
+};
\ No newline at end of file
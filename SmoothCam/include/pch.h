@@ -11,6 +11,7 @@
 #include <fstream>
 #include <array>
 #include <mutex>
+#include <atomic>
 #include <tuple>
 
 #include <codeanalysis\warnings.h>
@@ -113,6 +114,7 @@
 #   endif
 #endif
 
+#include "async_log.h"
 #include "basicdetour.h"
 #include "havok/hkp3AxisSweep.h"
 
@@ -129,6 +131,8 @@
 #include "config.h"
 
 static inline void FatalError(const wchar_t* message) noexcept {
+	// Get anything already logged onto disk before we go down
+	AsyncLog::Flush();
 	MessageBox(nullptr, message, L"SmoothCamera", MB_ICONERROR);
 	exit(-1);
 }
\ No newline at end of file
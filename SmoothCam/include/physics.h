@@ -3,4 +3,8 @@
 namespace Physics {
 	hkp3AxisSweep* GetBroadphase(const bhkWorld* physicsWorld);
 	bhkWorld* GetWorld(const TESObjectCELL* parentCell);
+	// Returns the physics world of the player's cell, only asking the engine again when the cell changes or is reattached
+	bhkWorld* GetCurrentWorld(const PlayerCharacter* player);
+	// Drops the cached world so the next GetCurrentWorld call looks it up again
+	void InvalidateWorldCache() noexcept;
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#ifdef _DEBUG
+// Records what the engine computes for the camera projection, to refresh the fixtures in Tests/fixtures
+// Each file in Data/SKSE/Plugins is written in its fixture's format, copy it over the fixture to update it
+namespace ProjectionCapture {
+	// Runs NiCamera::UpdateWorldToScreenMtx (69271) for the camera with the given rotation, with its own frustum and
+	// an orthographic one, and records the inputs along with the m_aafWorldToCam it built
+	void WorldToScreen(NiCamera* camera, const NiMatrix33& rotation) noexcept;
+	// Runs NiCamera::WorldPtToScreenPt3 over the crosshair hit and points around the near plane and behind the camera,
+	// and records each point with the screen position and visibility it returned
+	void Points(NiCamera* camera, const mmath::NiMatrix44& worldToScreen, const NiRect<float>& port,
+		const glm::vec3& hitPos) noexcept;
+}
+#endif
\ No newline at end of file
@@ -69,4 +69,16 @@ namespace Raycast {
 	//		A structure holding the results of the ray cast.
 	//		If the ray hit something, result.hit will be true.
 	RayResult hkpCastRay(glm::vec4 start, glm::vec4 end);
+
+	// Casts along each segment of a path in turn, stopping at the first one that hits something
+	// Uses the same collision as hkpCastRay
+	//	Params:
+	//		const glm::vec3* points: The path in world space
+	//		size_t count:            Number of points in the path
+	//
+	// Returns:
+	//	RayResult:
+	//		The result of the segment that hit, with rayLength measured along the path from its start.
+	//		If nothing was hit, result.hit will be false.
+	RayResult hkpCastPath(const glm::vec3* points, size_t count);
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+// A fixed capacity, wait-free queue for exactly one producer thread and one consumer thread
+// Capacity must be a power of two
+template<typename T, size_t Capacity>
+class SPSCRing {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static_assert(std::is_trivially_copyable<T>(), "Ring entries are copied in and out as plain values");
+
+	public:
+		// Producer only - returns false and counts a drop if the ring is full
+		bool Push(const T& value) noexcept {
+			const auto head = writeHead.load(std::memory_order_relaxed);
+			if (head - readHead.load(std::memory_order_acquire) >= Capacity) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			items[head & (Capacity - 1)] = value;
+			writeHead.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer only - returns false if the ring is empty
+		bool Pop(T& value) noexcept {
+			const auto tail = readHead.load(std::memory_order_relaxed);
+			if (tail == writeHead.load(std::memory_order_acquire)) return false;
+
+			value = items[tail & (Capacity - 1)];
+			readHead.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Returns the number of pushes rejected because the ring was full
+		uint32_t Dropped() const noexcept {
+			return dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		// Keep the two ends on separate cache lines so the threads don't fight over them
+		alignas(64) std::atomic<size_t> writeHead = 0;
+		alignas(64) std::atomic<size_t> readHead = 0;
+		std::atomic<uint32_t> dropped = 0;
+		std::array<T, Capacity> items;
+};
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+// Eases a fixed set of float channels towards new targets over time
+// Channels are stored as parallel arrays and only the running ones are touched each update
+template<size_t Count>
+class TransitionPool {
+	static_assert(Count > 0 && Count <= 32, "Channel state is tracked in a 32 bit mask");
+
+	public:
+		// Sets how a channel moves to new targets, a disabled channel jumps straight to them
+		void Configure(size_t channel, bool enabled, float duration, Config::ScalarMethods method) noexcept {
+			const auto bit = 1u << channel;
+			enabledMask = enabled ? (enabledMask | bit) : (enabledMask & ~bit);
+			invDuration[channel] = 1.0f / glm::max(duration, 0.01f);
+			methods[channel] = method;
+		}
+
+		// Starts moving a channel to target, if it isn't already heading there
+		void SetTarget(size_t channel, float target, double curTime) noexcept {
+			if ((enabledMask & (1u << channel)) == 0) {
+				Snap(channel, target);
+				return;
+			}
+
+			if (target == targets[channel]) return;
+			from[channel] = current[channel];
+			targets[channel] = target;
+			startTimes[channel] = curTime;
+			runningMask |= 1u << channel;
+		}
+
+		// Jumps a channel straight to value, stopping any transition
+		void Snap(size_t channel, float value) noexcept {
+			from[channel] = targets[channel] = current[channel] = value;
+			runningMask &= ~(1u << channel);
+		}
+
+		// Advances every running channel to curTime
+		void Update(double curTime) noexcept {
+			if (runningMask == 0) return;
+
+			// Progress for all channels in one pass, idle ones are ignored below
+			std::array<float, Count> progress;
+			for (size_t i = 0; i < Count; i++)
+				progress[i] = glm::clamp(static_cast<float>(curTime - startTimes[i]) * invDuration[i], 0.0f, 1.0f);
+
+			// Ease each running channel, then interpolate them all in one kernel call
+			alignas(16) std::array<float, Count> scalars = {};
+			alignas(16) std::array<float, Count> next;
+			auto mask = runningMask;
+			while (mask != 0) {
+				const auto i = static_cast<size_t>(glm::findLSB(mask));
+				mask &= mask - 1;
+				if (progress[i] < 1.0f)
+					scalars[i] = mmath::RunScalarFunction<float>(methods[i], progress[i]);
+			}
+			mmath::InterpolateChannels(from.data(), targets.data(), scalars.data(), Count, next.data());
+
+			mask = runningMask;
+			while (mask != 0) {
+				const auto i = static_cast<size_t>(glm::findLSB(mask));
+				mask &= mask - 1;
+
+				if (progress[i] < 1.0f) {
+					current[i] = next[i];
+				} else {
+					from[i] = current[i] = targets[i];
+					runningMask &= ~(1u << i);
+				}
+			}
+		}
+
+		// Returns the current value of a channel
+		float Get(size_t channel) const noexcept {
+			return current[channel];
+		}
+
+		// Returns true if any channel is still moving
+		bool IsRunning() const noexcept {
+			return runningMask != 0;
+		}
+
+	private:
+		alignas(16) std::array<float, Count> from = {};
+		alignas(16) std::array<float, Count> targets = {};
+		alignas(16) std::array<float, Count> current = {};
+		alignas(16) std::array<float, Count> invDuration = {};
+		std::array<double, Count> startTimes = {};
+		std::array<Config::ScalarMethods, Count> methods = {};
+		uint32_t runningMask = 0;
+		uint32_t enabledMask = 0;
+};
\ No newline at end of file
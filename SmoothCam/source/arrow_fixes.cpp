@@ -2,16 +2,149 @@
 #include "game_state.h"
 
 #ifdef DEBUG_DRAWING
-SkyrimSE::ArrowProjectile* current;
-std::mutex segmentLock;
-std::vector<std::tuple<glm::vec3, glm::vec3>> segments;
+#include "spsc_ring.h"
+
+namespace {
+	// Written by the projectile detours, read by Draw
+	typedef struct {
+		enum class Kind : uint8_t {
+			Spawn,
+			Segment
+		};
+
+		Kind kind;
+		uint32_t handle;
+		glm::vec3 from;
+		glm::vec3 to;
+	} TraceRecord;
+	SPSCRing<TraceRecord, 4096> traceRing;
+
+	// The recorded path of one of the player's arrows, owned by the consumer
+	typedef struct {
+		uint32_t handle = 0;
+		// Which shot this was, counting from plugin load
+		uint32_t shot = 0;
+		std::vector<std::tuple<glm::vec3, glm::vec3>> segments;
+	} ArrowTrace;
+
+	constexpr size_t maxTracedArrows = 8;
+	std::array<ArrowTrace, maxTracedArrows> traces;
+	// Slot the next new arrow will take, evicting the oldest trace
+	size_t nextTrace = 0;
+	uint32_t shotCount = 0;
+	bool exportPressed = false;
+
+	// Starts a new trace for the arrow, replacing the oldest one
+	ArrowTrace& BeginTrace(uint32_t handle) {
+		auto& trace = traces[nextTrace];
+		nextTrace = (nextTrace + 1) % maxTracedArrows;
+		trace.handle = handle;
+		trace.shot = ++shotCount;
+		trace.segments.clear();
+		return trace;
+	}
+
+	// Returns the trace for the arrow, starting one if we missed its spawn
+	ArrowTrace& FindTrace(uint32_t handle) {
+		for (auto& trace : traces)
+			if (trace.shot != 0 && trace.handle == handle) return trace;
+		return BeginTrace(handle);
+	}
+
+	// Moves everything the detours recorded since the last frame into the traces
+	void DrainTraceRing() {
+		TraceRecord record;
+		while (traceRing.Pop(record)) {
+			if (record.kind == TraceRecord::Kind::Spawn) {
+				BeginTrace(record.handle);
+			} else {
+				FindTrace(record.handle).segments.emplace_back(record.from, record.to);
+			}
+		}
+	}
+
+	uint32_t GetHandle(TESObjectREFR* ref) {
+		UInt32 handle = 0;
+		(*CreateRefHandleByREFR)(&handle, ref);
+		return handle;
+	}
+}
+
+std::vector<glm::vec3> projectionPoints;
+std::vector<glm::vec3> projectionScreen;
+std::vector<uint8_t> projectionVisible;
+
+// Writes every recorded trajectory to path as csv, one row per trace segment
+// Must be called from the thread that calls Draw, which is the only consumer of the trace ring
+bool ArrowFixes::ExportTraces(const wchar_t* path) {
+	DrainTraceRing();
+
+	std::ofstream os(path);
+	if (!os.is_open()) {
+		LOG_WARNING("Failed to open arrow trace export file");
+		return false;
+	}
+
+	os << "shot,handle,segment,fromX,fromY,fromZ,toX,toY,toZ\n";
+	for (const auto& trace : traces) {
+		if (trace.shot == 0) continue;
+		for (size_t i = 0; i < trace.segments.size(); i++) {
+			const auto& [from, to] = trace.segments[i];
+			os << trace.shot << "," << trace.handle << "," << i << ","
+				<< from.x << "," << from.y << "," << from.z << ","
+				<< to.x << "," << to.y << "," << to.z << "\n";
+		}
+	}
+
+	if (traceRing.Dropped() != 0)
+		LOG_WARNING("%u arrow trace records were dropped, the ring was full", traceRing.Dropped());
+
+	return true;
+}
 
 void ArrowFixes::Draw() {
-	std::lock_guard<std::mutex> lock(segmentLock);
-	for (auto& cmd : segments) {
+	DrainTraceRing();
+
+	const auto state = GetAsyncKeyState(VK_END);
+	if (state && !exportPressed) {
+		exportPressed = true;
+		ExportTraces(L"Data/SKSE/Plugins/SmoothCam_ArrowTraces.csv");
+	} else if (!state) {
+		exportPressed = false;
+	}
+
+	const auto& worldToScreen = *reinterpret_cast<const mmath::NiMatrix44*>(g_worldToCamMatrix.GetPtr());
+
+	// Clip everything to the front of the camera, then project all of the end points in one go
+	projectionPoints.clear();
+	for (const auto& trace : traces) {
+		for (const auto& cmd : trace.segments) {
+			auto start = std::get<0>(cmd);
+			auto end = std::get<1>(cmd);
+			if (!mmath::ClipSegment(worldToScreen, start, end)) continue;
+			projectionPoints.push_back(start);
+			projectionPoints.push_back(end);
+		}
+	}
+	projectionScreen.resize(projectionPoints.size());
+	projectionVisible.resize(projectionPoints.size());
+
+	auto port = NiRect<float>();
+	port.m_left = -1.0f;
+	port.m_right = 1.0f;
+	port.m_top = 1.0f;
+	port.m_bottom = -1.0f;
+	mmath::ProjectPoints(
+		worldToScreen, port,
+		projectionPoints.data(), projectionPoints.size(),
+		projectionScreen.data(), projectionVisible.data()
+	);
+
+	for (size_t i = 0; i + 1 < projectionPoints.size(); i += 2) {
+		if (!projectionVisible[i] || !projectionVisible[i + 1]) continue;
 		DebugDrawing::Submit(DebugDrawing::DrawLine(
-			mmath::PointToScreen(std::get<0>(cmd)),
-			mmath::PointToScreen(std::get<1>(cmd))
+			static_cast<glm::vec2>(projectionScreen[i]),
+			static_cast<glm::vec2>(projectionScreen[i + 1])
 		));
 	}
 }
@@ -24,15 +157,14 @@ UInt32 mMaybeSpawnArrow(uint32_t* arrowHandle, ArrowFixes::LaunchData* launchDat
 	uintptr_t param_3, uintptr_t** param_4)
 {
 	auto ret = arrOrig(arrowHandle, launchData, param_3, param_4);
+
 	NiPointer<TESObjectREFR> ref;
 	UInt32 rc = *arrowHandle;
 	(*LookupREFRByHandle)(rc, ref);
 	auto asArrow = reinterpret_cast<SkyrimSE::ArrowProjectile*>(ref.get());
 
-	if (asArrow->shooter == 0x00100000) {
-		std::lock_guard<std::mutex> lock(segmentLock);
-		segments.clear();
-	}
+	if (asArrow && asArrow->shooter == 0x00100000)
+		traceRing.Push({ TraceRecord::Kind::Spawn, rc, {}, {} });
 	return ret;
 }
 
@@ -41,14 +173,57 @@ UpdateTraceArrowProjectile fnUpdateTraceArrowProjectile;
 std::unique_ptr<BasicDetour> detUpdateTraceArrowProjectile;
 uintptr_t mUpdateTraceArrowProjectile(SkyrimSE::ArrowProjectile* arrow, NiPoint3& to, NiPoint3& from) {
 	if (arrow->shooter == 0x00100000) {
-		std::lock_guard<std::mutex> lock(segmentLock);
-		segments.push_back(std::make_tuple(glm::vec3{ from.x, from.y, from.z }, glm::vec3{ to.x, to.y, to.z }));
+		traceRing.Push({
+			TraceRecord::Kind::Segment, GetHandle(arrow),
+			{ from.x, from.y, from.z }, { to.x, to.y, to.z }
+		});
 	}
 	auto ret = fnUpdateTraceArrowProjectile(arrow, to, from);
 	return ret;
 }
 #endif
 
+namespace {
+	typedef float(*GetAFloat)(SkyrimSE::ArrowProjectile*);
+	typedef void(*LookupFun)(uint32_t*, uintptr_t*);
+
+	// Engine functions and globals used by the flight path, resolved once in Attach
+	struct {
+		//578 - 1407320a0 - 42536
+		GetAFloat getSpeedMult = nullptr;
+		//580 - 1407320c0 - 42537
+		GetAFloat getGravity = nullptr;
+		// FUN_1401329d0
+		LookupFun lookupHandle = nullptr;
+		uintptr_t DAT_142eff7d8 = 0;
+		uintptr_t DAT_142ec5c60 = 0;
+	} engine;
+
+	// Returns the third person tilt applied to arrows fired from the weapon
+	float GetLaunchTilt(const TESObjectWEAP* weapon) noexcept {
+		if (!weapon) return 0.0f;
+		switch (weapon->gameData.type) {
+			case TESObjectWEAP::GameData::kType_CrossBow:
+			case TESObjectWEAP::GameData::kType_CBow:
+				return glm::radians(Config::GetGameConfig()->f3PBoltTiltUpAngle);
+			case TESObjectWEAP::GameData::kType_Bow:
+			case TESObjectWEAP::GameData::kType_Bow2:
+				return glm::radians(Config::GetGameConfig()->f3PArrowTiltUpAngle);
+			default:
+				return 0.0f;
+		}
+	}
+
+	// Returns the tilt for an arrow we didn't see launched, from whatever the player has equipped
+	float GetEquippedTilt() noexcept {
+		if (GameState::IsUsingCrossbow(*g_thePlayer))
+			return glm::radians(Config::GetGameConfig()->f3PBoltTiltUpAngle);
+		if (GameState::IsUsingBow(*g_thePlayer))
+			return glm::radians(Config::GetGameConfig()->f3PArrowTiltUpAngle);
+		return 0.0f;
+	}
+}
+
 //FUN_14084b430:49866
 typedef void(*FactorCameraOffset)(CorrectedPlayerCamera* camera, NiPoint3& pos, bool fac);
 FactorCameraOffset fnFactorCameraOffset;
@@ -96,10 +271,7 @@ void mUpdateArrowFlightPath(SkyrimSE::ArrowProjectile* arrow) {
 	if (arrow->shooter != camera->playerRef || camera->cameraState == camera->cameraStates[CorrectedPlayerCamera::kCameraState_FirstPerson])
 		return fnUpdateArrowFlightPath(arrow);
 
-	//578 - 1407320a0 - 42536
-	//580 - 1407320c0 - 42537
-	typedef float(*GetAFloat)(SkyrimSE::ArrowProjectile*);
-	auto gravity = Offsets::Get<GetAFloat>(42537)(arrow);
+	auto gravity = engine.getGravity(arrow);
 	
 	auto projectileForm = reinterpret_cast<BGSProjectile*>(arrow->baseForm);
 
@@ -108,16 +280,11 @@ void mUpdateArrowFlightPath(SkyrimSE::ArrowProjectile* arrow) {
 	if ((~(byte)(arrow->flags >> 0x1f) & 1) != 0) {
 		const auto mat = camera->cameraNode->m_localTransform.rot;
 
-		if (gravity == 1.0f) // assume this is a magic projectile
-			arrPitch = glm::asin(glm::clamp(-mat.data[2][1], -1.0f, 1.0f));
-		else {
-			if (GameState::IsUsingCrossbow(*g_thePlayer)) {
-				arrPitch = glm::asin(glm::clamp(-mat.data[2][1], -1.0f, 1.0f)) - glm::radians(Config::GetGameConfig()->f3PBoltTiltUpAngle);
-			} else if (GameState::IsUsingBow(*g_thePlayer)) {
-				arrPitch = glm::asin(glm::clamp(-mat.data[2][1], -1.0f, 1.0f)) - glm::radians(Config::GetGameConfig()->f3PArrowTiltUpAngle);
-			} else {
-				arrPitch = glm::asin(glm::clamp(-mat.data[2][1], -1.0f, 1.0f));
-			}
+		arrPitch = glm::asin(glm::clamp(-mat.data[2][1], -1.0f, 1.0f));
+		if (gravity != 1.0f) { // 1.0 is assumed to be a magic projectile, which isn't tilted
+			// Take the tilt from the weapon that fired this arrow, what is equipped now may have changed since
+			const auto weapon = arrow->weaponSource;
+			arrPitch -= weapon && weapon->formType == kFormType_Weapon ? GetLaunchTilt(weapon) : GetEquippedTilt();
 		}
 
 		arrRotation = camera->lookYaw;
@@ -129,7 +296,7 @@ void mUpdateArrowFlightPath(SkyrimSE::ArrowProjectile* arrow) {
 	float _X = projectileForm->data.speed;
 
 	//arrow->unk175(); // fVar5 = (float)(**(code**)(*(longlong*)param_1 + 0x578))();
-	float fVar5 = Offsets::Get<GetAFloat>(42536)(arrow);
+	float fVar5 = engine.getSpeedMult(arrow);
 	fVar5 = fVar5 * _X;
 
 	//arrow->unk176(); //_X = (float)(**(code **)(*(longlong *)param_1 + 0x580))(param_1);
@@ -150,17 +317,12 @@ void mUpdateArrowFlightPath(SkyrimSE::ArrowProjectile* arrow) {
 	arrow->velocityVector.y = fVar5 * _X;
 	arrow->velocityVector.z = fVar4;
 
-	typedef void(*LookupFun)(uint32_t*, uintptr_t*);
-
 	uint32_t local_res8 = arrow->shooter;
 	uintptr_t local_res10 = 0;
-	Offsets::Get<LookupFun>(12204)(&local_res8, &local_res10); // FUN_1401329d0
-	auto uVar3 = local_res10;
+	engine.lookupHandle(&local_res8, &local_res10);
 
-	uintptr_t DAT_142eff7d8 = Offsets::Get<uintptr_t>(514905);
-	uintptr_t DAT_142ec5c60 = Offsets::Get<uintptr_t>(514725);
-	if (((local_res10 != 0) && (local_res10 == DAT_142eff7d8)) &&
-		(*(int*)(DAT_142ec5c60 + 0x20) != 4))
+	if (((local_res10 != 0) && (local_res10 == engine.DAT_142eff7d8)) &&
+		(*(int*)(engine.DAT_142ec5c60 + 0x20) != 4))
 	{
 		NiPoint3 local_70;
 		//(**(code **)(*ThePlayer + 0x430))(ThePlayer, &local_70);
@@ -172,10 +334,16 @@ void mUpdateArrowFlightPath(SkyrimSE::ArrowProjectile* arrow) {
 
 	// Like other handle refcounters, arg1 = 0, release rc if arg2 != nullptr
 	local_res8 = 0;
-	Offsets::Get<LookupFun>(12204)(&local_res8, &local_res10);
+	engine.lookupHandle(&local_res8, &local_res10);
 }
 
 bool ArrowFixes::Attach() {
+	engine.getSpeedMult = Offsets::Get<GetAFloat>(42536);
+	engine.getGravity = Offsets::Get<GetAFloat>(42537);
+	engine.lookupHandle = Offsets::Get<LookupFun>(12204);
+	engine.DAT_142eff7d8 = Offsets::Get<uintptr_t>(514905);
+	engine.DAT_142ec5c60 = Offsets::Get<uintptr_t>(514725);
+
 	{
 		//FUN_14084b430:FactorCameraOffset:GetEyeVector
 		fnFactorCameraOffset = Offsets::Get<FactorCameraOffset>(49866);
@@ -185,7 +353,7 @@ bool ArrowFixes::Attach() {
 		);
 
 		if (!detFactorCameraOffset->Attach()) {
-			_ERROR("Failed to place detour on target function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target function, this error is fatal.");
 			FatalError(L"Failed to place detour on target function, this error is fatal.");
 		}
 	}
@@ -199,7 +367,7 @@ bool ArrowFixes::Attach() {
 		);
 
 		if (!detArrowFlightPath->Attach()) {
-			_ERROR("Failed to place detour on target function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target function, this error is fatal.");
 			FatalError(L"Failed to place detour on target function, this error is fatal.");
 		}
 	}
@@ -213,7 +381,7 @@ bool ArrowFixes::Attach() {
 		);
 
 		if (!detMaybeArrow->Attach()) {
-			_ERROR("Failed to place detour on target function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target function, this error is fatal.");
 			FatalError(L"Failed to place detour on target function, this error is fatal.");
 		}
 	}
@@ -227,7 +395,7 @@ bool ArrowFixes::Attach() {
 			);
 
 		if (!detUpdateTraceArrowProjectile->Attach()) {
-			_ERROR("Failed to place detour on target function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target function, this error is fatal.");
 			FatalError(L"Failed to place detour on target function, this error is fatal.");
 		}
 	}
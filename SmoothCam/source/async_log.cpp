@@ -0,0 +1,244 @@
+#include "async_log.h"
+
+#include <thread>
+
+namespace {
+	// How often the writer wakes to drain the queue
+	constexpr auto writeInterval = std::chrono::milliseconds(50);
+	// Lines each call site may log per second before the rest are suppressed
+	constexpr uint32_t maxLinesPerSecond = 10;
+
+	MPSCRing<AsyncLog::Entry, 512> queue;
+	std::atomic<bool> debugEnabled = false;
+
+	struct {
+		std::thread writer;
+		bool running = false;
+		double secondsPerTick = 0.0;
+		int64_t startTicks = 0;
+		uint32_t reportedDrops = 0;
+		// Flush bumps requested and waits for the writer to catch up in completed
+		std::atomic<uint64_t> flushRequested = 0;
+		std::atomic<uint64_t> flushCompleted = 0;
+	} logger;
+
+	int64_t TicksPerSecond() noexcept {
+		static const auto frequency = [] {
+			LARGE_INTEGER f;
+			QueryPerformanceFrequency(&f);
+			return static_cast<int64_t>(f.QuadPart);
+		}();
+		return frequency;
+	}
+
+	struct ThreadGuard {
+		// The game may exit with the writer still running, don't let std::thread terminate us on unload
+		~ThreadGuard() {
+			if (logger.writer.joinable())
+				logger.writer.detach();
+		}
+	} threadGuard;
+
+	// Formats an entry the way printf would, with length modifiers replaced to match the captured types
+	void Format(const AsyncLog::Entry& entry, std::string& out) {
+		char spec[32];
+		char buf[256];
+		size_t argIndex = 0;
+
+		for (auto c = entry.format; *c; c++) {
+			if (*c != '%') {
+				out.push_back(*c);
+				continue;
+			}
+			if (c[1] == '%') {
+				out.push_back('%');
+				c++;
+				continue;
+			}
+
+			// Keep flags, width and precision
+			size_t len = 0;
+			spec[len++] = '%';
+			auto p = c + 1;
+			while (*p && strchr("-+ #0123456789.", *p) && len < sizeof(spec) - 4)
+				spec[len++] = *p++;
+			// Drop the length modifier
+			while (*p && strchr("hljztLIw", *p)) {
+				if (*p == 'I' && ((p[1] == '6' && p[2] == '4') || (p[1] == '3' && p[2] == '2'))) p += 2;
+				p++;
+			}
+
+			const auto conversion = *p;
+			if (!conversion) break;
+			if (!strchr("diouxXceEfFgGaAsp", conversion)) {
+				// Not something we can defer, print the spec as is
+				out.append(c, p - c + 1);
+				c = p;
+				continue;
+			}
+			c = p;
+
+			if (argIndex >= entry.argCount) {
+				out += "<missing>";
+				continue;
+			}
+			const auto& arg = entry.args[argIndex++];
+
+			int written = -1;
+			if (strchr("diouxX", conversion)) {
+				spec[len++] = 'l';
+				spec[len++] = 'l';
+				spec[len++] = conversion;
+				spec[len] = 0;
+				const auto value = arg.type == AsyncLog::ArgType::Double ? static_cast<int64_t>(arg.d) : arg.i;
+				written = snprintf(buf, sizeof(buf), spec, static_cast<long long>(value));
+			} else if (conversion == 'c') {
+				spec[len++] = conversion;
+				spec[len] = 0;
+				written = snprintf(buf, sizeof(buf), spec, static_cast<int>(arg.i));
+			} else if (strchr("eEfFgGaA", conversion)) {
+				spec[len++] = conversion;
+				spec[len] = 0;
+				const auto value = arg.type == AsyncLog::ArgType::Double ? arg.d :
+					arg.type == AsyncLog::ArgType::Int ? static_cast<double>(arg.i) : static_cast<double>(arg.u);
+				written = snprintf(buf, sizeof(buf), spec, value);
+			} else if (conversion == 's') {
+				spec[len++] = conversion;
+				spec[len] = 0;
+				const auto str = arg.type == AsyncLog::ArgType::String ? entry.text + arg.text : "<not a string>";
+				written = snprintf(buf, sizeof(buf), spec, str);
+			} else {
+				written = snprintf(buf, sizeof(buf), "%p", arg.p);
+			}
+
+			if (written > 0)
+				out.append(buf, std::min(static_cast<size_t>(written), sizeof(buf) - 1));
+		}
+	}
+
+	void WriteEntry(const AsyncLog::Entry& entry, std::string& line) {
+		const auto time = static_cast<double>(entry.ticks - logger.startTicks) * logger.secondsPerTick;
+
+		char prefix[48];
+		snprintf(prefix, sizeof(prefix), "[%.3f T%u] ", time, entry.threadId);
+		line = prefix;
+		Format(entry, line);
+		if (entry.suppressed > 0) {
+			char note[64];
+			snprintf(note, sizeof(note), " (%u more suppressed)", entry.suppressed);
+			line += note;
+		}
+
+		switch (entry.level) {
+			case AsyncLog::Level::Debug:
+				_DMESSAGE("%s", line.c_str());
+				break;
+			case AsyncLog::Level::Message:
+				_MESSAGE("%s", line.c_str());
+				break;
+			case AsyncLog::Level::Warning:
+				_WARNING("%s", line.c_str());
+				break;
+			case AsyncLog::Level::Error:
+				_ERROR("%s", line.c_str());
+				break;
+		}
+	}
+
+	void WriterThread() {
+		AsyncLog::Entry entry;
+		std::string line;
+		for (;;) {
+			std::this_thread::sleep_for(writeInterval);
+
+			// Anything pushed before a flush request was made is drained by this pass
+			const auto flushRequest = logger.flushRequested.load(std::memory_order_acquire);
+			while (queue.Pop(entry))
+				WriteEntry(entry, line);
+
+			const auto dropped = queue.Dropped();
+			if (dropped != logger.reportedDrops) {
+				_WARNING("%u log lines were dropped, the log queue was full", dropped - logger.reportedDrops);
+				logger.reportedDrops = dropped;
+			}
+			logger.flushCompleted.store(flushRequest, std::memory_order_release);
+		}
+	}
+}
+
+// Starts the writer thread, lines logged before this are held until it runs
+void AsyncLog::Start() {
+	if (logger.running) return;
+
+	logger.secondsPerTick = 1.0 / static_cast<double>(TicksPerSecond());
+	logger.startTicks = Ticks();
+	logger.writer = std::thread(WriterThread);
+	logger.running = true;
+}
+
+// Returns true if LOG_DEBUG lines should be logged
+bool AsyncLog::DebugEnabled() noexcept {
+	return debugEnabled.load(std::memory_order_relaxed);
+}
+
+void AsyncLog::SetDebugEnabled(bool enabled) noexcept {
+	debugEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Blocks until every line queued before the call has been written, or a second has passed
+void AsyncLog::Flush() noexcept {
+	if (!logger.running) return;
+
+	const auto request = logger.flushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+	while (logger.flushCompleted.load(std::memory_order_acquire) < request) {
+		if (std::chrono::steady_clock::now() >= deadline) return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+// Returns false if the call site has used up its lines for this second
+// The window is shared by every thread logging from the site, a few extra lines can slip through a reset
+bool AsyncLog::Admit(CallSite& site, int64_t ticks, uint32_t& suppressed) noexcept {
+	auto start = site.windowStart.load(std::memory_order_relaxed);
+	if (ticks - start >= TicksPerSecond() && site.windowStart.compare_exchange_strong(start, ticks, std::memory_order_relaxed)) {
+		// Only the thread that opened the window reports what the last ones turned away
+		site.windowCount.store(0, std::memory_order_relaxed);
+		suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+	}
+
+	if (site.windowCount.fetch_add(1, std::memory_order_relaxed) >= maxLinesPerSecond) {
+		// Hand the count back for the next window
+		site.suppressed.fetch_add(suppressed + 1, std::memory_order_relaxed);
+		suppressed = 0;
+		return false;
+	}
+	return true;
+}
+
+// Queues a captured line, drops it if the writer has fallen behind
+void AsyncLog::Submit(const Entry& entry) noexcept {
+	queue.Push(entry);
+}
+
+int64_t AsyncLog::Ticks() noexcept {
+	LARGE_INTEGER i;
+	QueryPerformanceCounter(&i);
+	return i.QuadPart;
+}
+
+// Copies a string argument into the entry, the caller's string may be gone by the time it is written
+void AsyncLog::Detail::CaptureText(Entry& entry, Arg& arg, const char* str) noexcept {
+	arg.type = ArgType::String;
+	arg.text = entry.textUsed;
+	if (entry.textUsed >= maxText) {
+		arg.text = maxText - 1;
+		return;
+	}
+
+	const auto room = maxText - entry.textUsed - 1;
+	const auto len = str ? std::min(strlen(str), room) : 0;
+	if (len > 0) memcpy(entry.text + entry.textUsed, str, len);
+	entry.text[entry.textUsed + len] = 0;
+	entry.textUsed = static_cast<uint16_t>(entry.textUsed + len + 1);
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "camera.h"
 #include "arrow_fixes.h"
+#include "projection_capture.h"
 #ifdef _DEBUG
 #ifdef DEBUG_DRAWING
 #include "debug_drawing.h"
@@ -11,44 +12,131 @@ double CurQPC() noexcept;
 double GetFrameDelta() noexcept;
 double GetQPCDelta() noexcept;
 
-Camera::SmoothCamera::SmoothCamera() noexcept : config(Config::GetCurrentConfig()) {
+Camera::SmoothCamera::SmoothCamera() noexcept : cold(std::make_unique<ColdState>()), config(Config::GetCurrentConfig()) {
 	cameraStates[static_cast<size_t>(GameState::CameraState::ThirdPerson)] =
 		std::move(std::make_unique<State::ThirdpersonState>(this));
 	cameraStates[static_cast<size_t>(GameState::CameraState::ThirdPersonCombat)] =
 		std::move(std::make_unique<State::ThirdpersonCombatState>(this));
 	cameraStates[static_cast<size_t>(GameState::CameraState::Horseback)] =
 		std::move(std::make_unique<State::ThirdpersonHorseState>(this));
+
+	RebuildOffsetTable();
 }
 
 // Called when the player toggles the POV
+// Runs on the input thread - only queue the event, it is applied by ProcessInputQueue
 void Camera::SmoothCamera::OnTogglePOV(const ButtonEvent* ev) noexcept {
-	povIsThird = !povIsThird;
-	povWasPressed = true;
+	// Held keys repeat every frame, only the press and release matter
+	if (!ev->IsDown() && !ev->IsUp()) return;
+	cold->inputQueue.Push({ InputControl::TogglePOV, ev->keyMask, ev->timer });
 }
 
+// Called when any other key is pressed
+// Runs on the input thread - only queue the event, it is applied by ProcessInputQueue
 void Camera::SmoothCamera::OnKeyPress(const ButtonEvent* ev) noexcept {
-	if (config->shoulderSwapKey >= 0 && config->shoulderSwapKey == ev->keyMask && ev->timer <= 0.000001f) {
+	// Held keys repeat every frame, only the press and release matter
+	if (!ev->IsDown() && !ev->IsUp()) return;
+	cold->inputQueue.Push({ InputControl::Key, ev->keyMask, ev->timer });
+}
+
+// Starts or stops the recorder to match the config, and begins a record if it is running
+void Camera::SmoothCamera::BeginFrameTrace() noexcept {
+	if (config->enableFlightRecorder != FlightRecorder::IsRunning()) {
+		if (!config->enableFlightRecorder)
+			FlightRecorder::Stop();
+		else if (!FlightRecorder::Start())
+			config->enableFlightRecorder = false;
+	}
+
+	cold->trace.active = FlightRecorder::IsRunning();
+	if (!cold->trace.active) return;
+
+	cold->trace.record = {};
+	cold->trace.frameStart = cold->trace.zoneStart = FlightRecorder::Ticks();
+}
+
+// Times the zone since the last one ended
+void Camera::SmoothCamera::EndTraceZone(FlightRecorder::Zone zone) noexcept {
+	if (!cold->trace.active) return;
+
+	const auto now = FlightRecorder::Ticks();
+	cold->trace.record.zoneMicros[static_cast<size_t>(zone)] = FlightRecorder::TicksToMicros(now - cold->trace.zoneStart);
+	cold->trace.zoneStart = now;
+}
+
+// Fills in the rest of the record and queues it
+void Camera::SmoothCamera::EndFrameTrace(GameState::CameraState state, CameraActionState actionState,
+	WeaponStance stance) noexcept
+{
+	if (!cold->trace.active) return;
+
+	auto& record = cold->trace.record;
+	record.time = CurTime();
+	record.frameDelta = static_cast<float>(GetFrameDelta());
+	record.cameraState = static_cast<uint8_t>(state);
+	record.actionState = static_cast<uint8_t>(actionState);
+	record.weaponStance = static_cast<uint8_t>(stance);
+	if (sim.fixedStep.stepped) record.flags |= FlightRecorder::FixedStep;
+	if (cold->dialogMenuOpen) record.flags |= FlightRecorder::DialogOpen;
+	FlightRecorder::Store(record.position, sim.currentPosition);
+	record.zoneMicros[static_cast<size_t>(FlightRecorder::Zone::Total)] =
+		FlightRecorder::TicksToMicros(FlightRecorder::Ticks() - cold->trace.frameStart);
+
+	FlightRecorder::Submit(record);
+}
+
+// Applies the input queued since the last frame, collapsing repeats into a single state change
+void Camera::SmoothCamera::ProcessInputQueue() noexcept {
+	uint32_t povToggles = 0;
+	uint32_t shoulderSwaps = 0;
+
+	InputRecord record;
+	while (cold->inputQueue.Pop(record)) {
+		switch (record.control) {
+			case InputControl::TogglePOV:
+				// The release carries how long the key was held, only the press toggles
+				if (record.timer <= 0.000001f)
+					povToggles++;
+				break;
+			case InputControl::Key:
+				if (config->shoulderSwapKey >= 0 && config->shoulderSwapKey == record.keyMask && record.timer <= 0.000001f)
+					shoulderSwaps++;
+				break;
+		}
+	}
+
+	if (povToggles > 0) {
+		if (povToggles & 1) cold->povIsThird = !cold->povIsThird;
+		cold->povWasPressed = true;
+	}
+
+	if (shoulderSwaps & 1)
 		shoulderSwap = shoulderSwap == 1 ? -1 : 1;
+
+	const auto dropped = cold->inputQueue.Dropped();
+	if (dropped != cold->inputDropsReported) {
+		LOG_DEBUG("%u input events were dropped, the input queue was full", dropped - cold->inputDropsReported);
+		cold->inputDropsReported = dropped;
 	}
 }
 
 void Camera::SmoothCamera::OnDialogMenuChanged(const MenuOpenCloseEvent* const ev) noexcept {
-	dialogMenuOpen = ev->opening;
+	cold->dialogMenuOpen = ev->opening;
 }
 
 glm::vec3 Camera::SmoothCamera::GetCurrentPosition() const noexcept {
-	return currentPosition;
+	return sim.currentPosition;
 }
 
 // Updates our POV state to the true value the game expects for each state
 const bool Camera::SmoothCamera::UpdateCameraPOVState(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) noexcept {
 	const auto zoom = reinterpret_cast<const CorrectedThirdPersonState*>(camera)->cameraZoom;
 	const auto lzoom = reinterpret_cast<const CorrectedThirdPersonState*>(camera)->cameraLastZoom;
-	povIsThird = zoom == 0.0f || GameState::IsInAutoVanityCamera(camera) || GameState::IsInTweenCamera(camera) ||
+	cold->povIsThird = zoom == 0.0f || GameState::IsInAutoVanityCamera(camera) || GameState::IsInTweenCamera(camera) ||
 		GameState::IsInCameraTransition(camera) || GameState::IsInUsingObjectCamera(camera) || GameState::IsInKillMove(camera) ||
 		GameState::IsInBleedoutCamera(camera) || GameState::IsInFurnitureCamera(camera) || GameState::IsInHorseCamera(camera) ||
 		GameState::IsInDragonCamera(camera) || GameState::IsThirdPerson(camera);
-	return povIsThird;
+	return cold->povIsThird;
 }
 
 #pragma region Camera state updates
@@ -71,7 +159,7 @@ bool Camera::SmoothCamera::CameraNearHead(const PlayerCharacter* player, const C
 			niOrigin.y,
 			niOrigin.z
 		},
-		gameLastActualPosition
+		sim.gameLastActualPosition
 	);
 
 	return dist <= cutOff;
@@ -89,7 +177,7 @@ bool Camera::SmoothCamera::IFPV_InFirstPersonState(const PlayerCharacter* player
 // Returns the current camera state for use in selecting an update method
 const GameState::CameraState Camera::SmoothCamera::GetCurrentCameraState(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) {
 	GameState::CameraState newState = GameState::CameraState::Unknown;
-	if (!povWasPressed && !GameState::IsInHorseCamera(camera) && !GameState::IsInDragonCamera(camera) && GameState::IsSitting(player) 
+	if (!cold->povWasPressed && !GameState::IsInHorseCamera(camera) && !GameState::IsInDragonCamera(camera) && GameState::IsSitting(player) 
 		&& !GameState::IsSleeping(player) && config->compatIC_FirstPersonSitting)
 	{
 		const auto tps = reinterpret_cast<const CorrectedThirdPersonState*>(camera->cameraState);
@@ -123,7 +211,7 @@ const GameState::CameraState Camera::SmoothCamera::GetCurrentCameraState(const P
 				currentActionState == CameraActionState::FirstPersonHorseback ||
 				CameraNearHead(player, camera))
 			{
-				if (povWasPressed)
+				if (cold->povWasPressed)
 					newState = GameState::CameraState::Horseback;
 				else
 					newState = GameState::CameraState::FirstPerson;
@@ -165,7 +253,7 @@ const Camera::CameraActionState Camera::SmoothCamera::GetCurrentCameraActionStat
 
 	if (GameState::IsInHorseCamera(camera)) {
 		// Improved camera compat
-		if (!povIsThird) {
+		if (!cold->povIsThird) {
 			newState = CameraActionState::FirstPersonHorseback;
 		} else if (GameState::IsDisMountingHorse(player)) {
 			newState = CameraActionState::DisMounting;
@@ -323,146 +411,103 @@ const Config::OffsetGroup* Camera::SmoothCamera::GetOffsetForState(const CameraA
 	}
 }
 
-float Camera::SmoothCamera::GetActiveWeaponStateZoomOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept {
-	if (!GameState::IsWeaponDrawn(player)) return group->zoomOffset;
-	if (GameState::IsRangedWeaponDrawn(player)) {
-		return group->combatRangedZoomOffset;
-	}
-	if (GameState::IsMagicDrawn(player)) {
-		return group->combatMagicZoomOffset;
-	}
-	return group->combatMeleeZoomOffset;
-}
-
-// Selects the right offset from an offset group for the player's weapon state
-float Camera::SmoothCamera::GetActiveWeaponStateUpOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept {
-	if (!GameState::IsWeaponDrawn(player)) return group->upOffset;
-	if (GameState::IsRangedWeaponDrawn(player)) {
-		return group->combatRangedUpOffset;
-	}
-	if (GameState::IsMagicDrawn(player)) {
-		return group->combatMagicUpOffset;
-	}
-	return group->combatMeleeUpOffset;
-}
-
-// Selects the right offset from an offset group for the player's weapon state
-float Camera::SmoothCamera::GetActiveWeaponStateSideOffset(PlayerCharacter* player, const Config::OffsetGroup* group) const noexcept {
-	if (!GameState::IsWeaponDrawn(player)) return group->sideOffset;
-	if (GameState::IsRangedWeaponDrawn(player)) {
-		return group->combatRangedSideOffset;
-	}
-	if (GameState::IsMagicDrawn(player)) {
-		return group->combatMagicSideOffset;
-	}
-	return group->combatMeleeSideOffset;
-}
-
-float Camera::SmoothCamera::GetCurrentCameraZoomOffset(PlayerCharacter* player) const noexcept {
-	switch (currentState) {
-		case GameState::CameraState::Horseback: {
-			if (GameState::IsBowDrawn(player)) {
-				return config->bowAim.horseZoomOffset;
-			} else {
-				return GetActiveWeaponStateUpOffset(player, &config->horseback);
+// Resolves the offset and interp flag for the given states from the user config
+Camera::ResolvedOffset Camera::SmoothCamera::ResolveOffset(const CameraActionState state, const WeaponStance stance,
+	bool horseback) const noexcept
+{
+	// Selects the right values from an offset group for the player's weapon state
+	const auto selectForStance = [stance](const Config::OffsetGroup* group) noexcept {
+		ResolvedOffset ret;
+		switch (stance) {
+			case WeaponStance::Unarmed: {
+				ret.offset = { group->sideOffset, group->zoomOffset, group->upOffset };
+				ret.interp = group->interp;
+				break;
+			}
+			case WeaponStance::Ranged:
+			case WeaponStance::BowDrawn: {
+				ret.offset = { group->combatRangedSideOffset, group->combatRangedZoomOffset, group->combatRangedUpOffset };
+				ret.interp = group->interpRangedCombat;
+				break;
+			}
+			case WeaponStance::Magic: {
+				ret.offset = { group->combatMagicSideOffset, group->combatMagicZoomOffset, group->combatMagicUpOffset };
+				ret.interp = group->interpMagicCombat;
+				break;
+			}
+			case WeaponStance::Melee:
+			default: {
+				ret.offset = { group->combatMeleeSideOffset, group->combatMeleeZoomOffset, group->combatMeleeUpOffset };
+				ret.interp = group->interpMeleeCombat;
+				break;
 			}
 		}
-		default:
-			break;
-	}
-
-	switch (currentActionState) {
-		case CameraActionState::DisMounting:
-		case CameraActionState::Sleeping:
-		case CameraActionState::Sitting:
-		case CameraActionState::Aiming:
-		case CameraActionState::Swimming: {
-			return offsetState.currentGroup->zoomOffset;
-		}
-		case CameraActionState::Sneaking:
-		case CameraActionState::Sprinting:
-		case CameraActionState::Walking:
-		case CameraActionState::Running:
-		case CameraActionState::Standing: {
-			return GetActiveWeaponStateZoomOffset(player, offsetState.currentGroup);
-		}
-		default: {
-			break;
-		}
-	}
-	return 0.0f;
-}
+		return ret;
+	};
 
-// Returns the camera height for the current player state
-float Camera::SmoothCamera::GetCurrentCameraHeight(PlayerCharacter* player) const noexcept {
-	switch (currentState) {
-		case GameState::CameraState::Horseback: {
-			if (GameState::IsBowDrawn(player)) {
-				return config->bowAim.horseUpOffset;
-			} else {
-				return GetActiveWeaponStateUpOffset(player, &config->horseback);
-			}
+	if (horseback) {
+		if (stance == WeaponStance::BowDrawn) {
+			ResolvedOffset ret;
+			ret.offset = { config->bowAim.horseSideOffset, config->bowAim.horseZoomOffset, config->bowAim.horseUpOffset };
+			ret.interp = config->bowAim.interpHorseback;
+			return ret;
 		}
-		default:
-			break;
+		return selectForStance(&config->horseback);
 	}
 
-	switch (currentActionState) {
+	const auto group = GetOffsetForState(state);
+	auto ret = selectForStance(group);
+	switch (state) {
 		case CameraActionState::DisMounting:
 		case CameraActionState::Sleeping:
 		case CameraActionState::Sitting:
 		case CameraActionState::Aiming:
 		case CameraActionState::Swimming: {
-			return offsetState.currentGroup->upOffset;
+			// These states don't have per-weapon offsets
+			ret.offset = { group->sideOffset, group->zoomOffset, group->upOffset };
+			break;
 		}
 		case CameraActionState::Sneaking:
 		case CameraActionState::Sprinting:
 		case CameraActionState::Walking:
 		case CameraActionState::Running:
 		case CameraActionState::Standing: {
-			return GetActiveWeaponStateUpOffset(player, offsetState.currentGroup);
+			break;
 		}
 		default: {
+			ret.offset = { 0.0f, 0.0f, 0.0f };
 			break;
 		}
 	}
-	return 0.0f;
+	return ret;
 }
 
-// Returns the camera side offset for the current player state
-float Camera::SmoothCamera::GetCurrentCameraSideOffset(PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept {
-	switch (currentState) {
-		case GameState::CameraState::Horseback: {
-			if (GameState::IsBowDrawn(player)) {
-				return config->bowAim.horseSideOffset * shoulderSwap;
-			} else {
-				return GetActiveWeaponStateSideOffset(player, &config->horseback) * shoulderSwap;
+// Rebuilds the resolved offset table, call when the user config changes
+void Camera::SmoothCamera::RebuildOffsetTable() noexcept {
+	for (auto state = 0; state < static_cast<int>(CameraActionState::MAX_STATE); state++) {
+		for (auto stance = 0; stance < static_cast<int>(WeaponStance::MAX_STANCE); stance++) {
+			for (auto horseback = 0; horseback < 2; horseback++) {
+				cold->offsetTable[state][stance][horseback] = ResolveOffset(
+					static_cast<CameraActionState>(state),
+					static_cast<WeaponStance>(stance),
+					horseback != 0
+				);
 			}
 		}
-		default:
-			break;
 	}
+	cold->offsetTableRevision = Config::GetConfigRevision();
+}
 
-	switch (currentActionState) {
-		case CameraActionState::DisMounting:
-		case CameraActionState::Sleeping:
-		case CameraActionState::Sitting:
-		case CameraActionState::Aiming:
-		case CameraActionState::Swimming: {
-			return offsetState.currentGroup->sideOffset * shoulderSwap;
-		}
-		case CameraActionState::Sneaking:
-		case CameraActionState::Sprinting:
-		case CameraActionState::Walking:
-		case CameraActionState::Running:
-		case CameraActionState::Standing: {
-			return GetActiveWeaponStateSideOffset(player, offsetState.currentGroup) * shoulderSwap;
-		}
-		default: {
-			break;
-		}
+// Returns the current weapon stance of the player
+const Camera::WeaponStance Camera::SmoothCamera::GetCurrentWeaponStance(PlayerCharacter* player) const noexcept {
+	if (!GameState::IsWeaponDrawn(player)) return WeaponStance::Unarmed;
+	if (GameState::IsRangedWeaponDrawn(player)) {
+		return GameState::IsBowDrawn(player) ? WeaponStance::BowDrawn : WeaponStance::Ranged;
+	}
+	if (GameState::IsMagicDrawn(player)) {
+		return WeaponStance::Magic;
 	}
-	return 0.0f;
+	return WeaponStance::Melee;
 }
 
 // Returns the ideal camera distance for the current zoom level
@@ -471,11 +516,12 @@ float Camera::SmoothCamera::GetCurrentCameraDistance(const CorrectedPlayerCamera
 }
 
 // Returns the full local-space camera offset for the current player state
-glm::vec3 Camera::SmoothCamera::GetCurrentCameraOffset(PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept {
+glm::vec3 Camera::SmoothCamera::GetCurrentCameraOffset(const CorrectedPlayerCamera* camera) const noexcept {
+	const auto& ofs = offsetState.current->offset;
 	return {
-		GetCurrentCameraSideOffset(player, camera),
-		GetCurrentCameraDistance(camera) + GetCurrentCameraZoomOffset(player),
-		GetCurrentCameraHeight(player)
+		ofs.x * shoulderSwap,
+		GetCurrentCameraDistance(camera) + ofs.y,
+		ofs.z
 	};
 }
 
@@ -510,6 +556,12 @@ glm::vec3 Camera::SmoothCamera::GetCurrentCameraTargetWorldPosition(const Player
 }
 
 void Camera::SmoothCamera::SetPosition(const glm::vec3& pos, const CorrectedPlayerCamera* camera) noexcept {
+	// Fixed-step updates only advance the simulation, Present makes the one engine write for the frame
+	if (sim.fixedStep.stepping) {
+		sim.currentPosition = pos;
+		return;
+	}
+
 	auto cameraNode = camera->cameraNode;
 	auto cameraNi = reinterpret_cast<NiCamera*>(
 		cameraNode->m_children.m_size == 0 ?
@@ -518,18 +570,18 @@ void Camera::SmoothCamera::SetPosition(const glm::vec3& pos, const CorrectedPlay
 	);
 	if (!cameraNi) return;
 
-	currentPosition = pos;
+	sim.currentPosition = pos;
 
 #ifdef _DEBUG
-	if (!mmath::IsValid(currentPosition)) {
+	if (!mmath::IsValid(sim.currentPosition)) {
 		__debugbreak();
 		// Oops, go ahead and clear both
-		lastPosition = currentPosition = gameInitialWorldPosition;
+		sim.lastPosition = sim.currentPosition = sim.gameInitialWorldPosition;
 		return;
 	}
 #endif
 
-	const NiPoint3 niPos = { currentPosition.x, currentPosition.y, currentPosition.z };
+	const NiPoint3 niPos = { sim.currentPosition.x, sim.currentPosition.y, sim.currentPosition.z };
 	cameraNode->m_localTransform.pos = niPos;
 	cameraNode->m_worldTransform.pos = niPos;
 	cameraNi->m_worldTransform.pos = niPos;
@@ -540,23 +592,80 @@ void Camera::SmoothCamera::SetPosition(const glm::vec3& pos, const CorrectedPlay
 	}
 
 	// Update world to screen matrices
-	UpdateInternalWorldToScreenMatrix(cameraNi, GetCameraPitchRotation(camera), GetCameraYawRotation(camera));
+	UpdateInternalWorldToScreenMatrix(cameraNi, sim.currentBasis);
 	Offsets::Get<UpdateWorldToScreenMtx>(69271)(cameraNi);
 }
 
-void Camera::SmoothCamera::UpdateInternalWorldToScreenMatrix(NiCamera* camera, float pitch, float yaw) noexcept {
-	auto lastRotation = camera->m_worldTransform.rot;
-	camera->m_worldTransform.rot = mmath::ToddHowardTransform(pitch, yaw);
-	// Force the game to compute the matrix for us
-	Offsets::Get<UpdateWorldToScreenMtx>(69271)(camera);
-	// Grab it
-	worldToScreen = *reinterpret_cast<mmath::NiMatrix44*>(camera->m_aafWorldToCam);
-	// Now restore the normal camera rotation
-	camera->m_worldTransform.rot = lastRotation;
+void Camera::SmoothCamera::UpdateInternalWorldToScreenMatrix(NiCamera* camera, const mmath::CameraBasis& basis) noexcept {
+	const auto& pos = camera->m_worldTransform.pos;
+	const auto rotation = mmath::ToddHowardTransform(basis);
+	mmath::ComputeWorldToScreen(camera->m_frustum, rotation, { pos.x, pos.y, pos.z }, cold->worldToScreen);
+#ifdef _DEBUG
+	ProjectionCapture::WorldToScreen(camera, rotation);
+#endif
+}
+
+// Runs a camera state, at a fixed rate when fixed-step simulation is enabled
+void Camera::SmoothCamera::RunCameraState(State::BaseCameraState* state, PlayerCharacter* player, CorrectedPlayerCamera* camera) {
+	sim.fixedStep.stepped = false;
+	if (!config->fixedStepSimulation) {
+		sim.fixedStep.valid = false;
+		state->Update(player, camera, sim);
+		return;
+	}
+
+	// Past this many late steps we drop the time instead of trying to catch up
+	constexpr auto maxLateSteps = 4;
+	const auto step = 1.0 / static_cast<double>(glm::clamp(config->fixedStepRate, 10.0f, 1000.0f));
+	sim.fixedStep.accumulator = glm::min(sim.fixedStep.accumulator + GetFrameDelta(), step * maxLateSteps);
+
+	const auto target = GetCurrentCameraTargetWorldPosition(player, camera);
+	if (cold->trace.active)
+		FlightRecorder::Store(cold->trace.record.target, target);
+	if (!sim.fixedStep.valid || sim.fixedStep.accumulator >= step) {
+		// Run each late step on its own - the smoothing scalar is derived from the delta as if it were a frame
+		// rate, so one long step only moves as far as a single short one would
+		const auto steps = glm::clamp(static_cast<int>(sim.fixedStep.accumulator / step), 1, maxLateSteps);
+		sim.fixedStep.accumulator = glm::max(sim.fixedStep.accumulator - steps * step, 0.0);
+		sim.fixedStep.stepDelta = step;
+
+		for (auto i = 0; i < steps; i++) {
+			sim.fixedStep.stepping = true;
+			state->Update(player, camera, sim);
+			sim.fixedStep.stepping = false;
+			sim.fixedStep.stepped = true;
+
+			if (sim.fixedStep.valid) {
+				sim.fixedStep.lastPosition = sim.fixedStep.position;
+				sim.fixedStep.lastLocalOffset = sim.fixedStep.localOffset;
+			} else {
+				sim.fixedStep.lastPosition = sim.currentPosition - target;
+				sim.fixedStep.lastLocalOffset = sim.fixedStep.appliedLocalOffset;
+			}
+			sim.fixedStep.position = sim.currentPosition - target;
+			sim.fixedStep.localOffset = sim.fixedStep.appliedLocalOffset;
+			sim.fixedStep.valid = true;
+		}
+	}
+
+	// Blend between the last two steps, following the target at the frame rate so the player doesn't jitter
+	const auto alpha = static_cast<float>(glm::clamp(sim.fixedStep.accumulator / step, 0.0, 1.0));
+	state->Present(
+		player, camera, sim,
+		target + glm::mix(sim.fixedStep.lastPosition, sim.fixedStep.position, alpha),
+		glm::mix(sim.fixedStep.lastLocalOffset, sim.fixedStep.localOffset, alpha)
+	);
+}
+
+// Returns the time step the camera model is advancing by
+double Camera::SmoothCamera::GetSimulationDelta(const SimulationState& sim) noexcept {
+	return sim.fixedStep.stepping ? sim.fixedStep.stepDelta : GetFrameDelta();
 }
 
 // Returns the current smoothing scalar to use for the given distance to the player
-double Camera::SmoothCamera::GetCurrentSmoothingScalar(const float distance, ScalarSelector method) const {
+double Camera::SmoothCamera::GetCurrentSmoothingScalar(const SimulationState& sim, const float distance,
+	ScalarSelector method) const
+{
 	Config::ScalarMethods scalarMethod;
 	
 	// Work in FP64 here to eek out some more precision
@@ -587,7 +696,7 @@ double Camera::SmoothCamera::GetCurrentSmoothingScalar(const float distance, Sca
 	}
 
 	if (!config->disableDeltaTime) {
-		const double delta = glm::max(GetFrameDelta(), minZero);
+		const double delta = glm::max(GetSimulationDelta(sim), minZero);
 		const double fps = 1.0 / delta;
 		const double mul = -fps * glm::log2(1.0 - remapped);
 		interpValue = glm::clamp(1.0 - glm::exp2(-mul * delta), 0.0, 1.0);
@@ -616,33 +725,8 @@ std::tuple<glm::vec3, glm::vec3> Camera::SmoothCamera::GetDistanceClamping() con
 }
 
 // Returns true if interpolation is allowed in the current state
-bool Camera::SmoothCamera::IsInterpAllowed(PlayerCharacter* player) const noexcept {
-	auto ofs = offsetState.currentGroup;
-	if (currentState == GameState::CameraState::Horseback) {
-		if (GameState::IsWeaponDrawn(player) && GameState::IsBowDrawn(player)) {
-			return config->bowAim.interpHorseback;
-		} else {
-			ofs = &config->horseback;
-		}
-	}
-
-	if (!GameState::IsWeaponDrawn(player)) return ofs->interp;
-	if (GameState::IsRangedWeaponDrawn(player)) {
-		return ofs->interpRangedCombat;
-	}
-	if (GameState::IsMagicDrawn(player)) {
-		return ofs->interpMagicCombat;
-	}
-	return ofs->interpMeleeCombat;
-}
-
-// Constructs the view matrix for the camera
-glm::mat4 Camera::SmoothCamera::GetViewMatrix(const PlayerCharacter* player, const CorrectedPlayerCamera* camera) const noexcept {
-	// Build a rotation matrix to rotate the camera around pitch and yaw axes.
-	auto m = glm::identity<glm::mat4>();
-	m = glm::rotate(m, -GetCameraYawRotation(camera), Camera::UNIT_UP); // yaw
-	m = glm::rotate(m, -GetCameraPitchRotation(camera), Camera::UNIT_FORWARD); // pitch
-	return m;
+bool Camera::SmoothCamera::IsInterpAllowed() const noexcept {
+	return offsetState.current->interp;
 }
 #pragma endregion
 
@@ -652,6 +736,8 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 	NiPoint3 niOrigin = { 0.01f, 0.01f, 0.01f };
 	NiPoint3 niNormal = { 0.0f, 1.00f, 0.0f };
 	const auto bowDrawn = GameState::IsBowDrawn(player);
+	// The full angle the game tilts arrows up by at launch
+	auto launchTilt = 0.0f;
 	BSFixedString handNodeName = "WEAPON";
 
 	if (currentState != GameState::CameraState::Horseback) {
@@ -666,11 +752,7 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 			niOrigin = NiPoint3(player->pos.x, player->pos.y, node->m_worldTransform.pos.z);
 		}
 
-		const auto n = mmath::GetViewVector(
-			glm::vec3(0.0, 1.0, 0.0),
-			GetCameraPitchRotation(camera),
-			GetCameraYawRotation(camera)
-		);
+		const auto& n = sim.currentBasis.forward;
 		niNormal = NiPoint3(n.x, n.y, n.z);
 	}
 
@@ -680,18 +762,19 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 			const auto arrow = static_cast<NiNode*>(handNode->m_children.m_data[0]);
 			niOrigin = arrow->m_worldTransform.pos;
 
-			// @Note: I'm sure there is some way to make this perfect, but this is close enough
-			float fac = 0.0f;
 			if (GameState::IsUsingCrossbow(player)) {
-				fac = glm::radians(Config::GetGameConfig()->f3PBoltTiltUpAngle) * 0.5f;
+				launchTilt = glm::radians(Config::GetGameConfig()->f3PBoltTiltUpAngle);
 			} else if (GameState::IsUsingBow(player)) {
-				fac = glm::radians(Config::GetGameConfig()->f3PArrowTiltUpAngle) * 0.5f;
+				launchTilt = glm::radians(Config::GetGameConfig()->f3PArrowTiltUpAngle);
 			}
-			
+
+			// @Note: I'm sure there is some way to make this perfect, but this is close enough
+			const auto fac = launchTilt * 0.5f;
+
 			const auto n = mmath::GetViewVector(
 				glm::vec3(0.0, 1.0, 0.0),
-				GetCameraPitchRotation(camera) - fac,
-				GetCameraYawRotation(camera)
+				sim.currentBasis.pitch - fac,
+				sim.currentBasis.yaw
 			);
 			niNormal = NiPoint3(n.x, n.y, n.z);
 		}
@@ -702,19 +785,61 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 			niOrigin = NiPoint3(player->pos.x, player->pos.y, node->m_worldTransform.pos.z);
 		}
 
-		const auto n = mmath::GetViewVector(
-			glm::vec3(0.0, 1.0, 0.0),
-			GetCameraPitchRotation(camera),
-			GetCameraYawRotation(camera)
-		);
+		const auto& n = sim.currentBasis.forward;
 		niNormal = NiPoint3(n.x, n.y, n.z);
 	}
 
-	// Cast the aim ray
-	constexpr auto rayLength = 6000.0f; // Range of most (all?) arrows
+	// Cast the aim ray, or reuse the last one if aim hasn't moved
 	auto origin = glm::vec4(niOrigin.x, niOrigin.y, niOrigin.z, 0.0f);
-	auto ray = glm::vec4(niNormal.x, niNormal.y, niNormal.z, 0.0f) * rayLength;
-	const auto result = Raycast::hkpCastRay(origin, origin + ray);
+	const auto direction = glm::vec3(niNormal.x, niNormal.y, niNormal.z);
+	const auto curTime = CurTime();
+	if (ShouldRecastAimRay(static_cast<glm::vec3>(origin), direction, curTime)) {
+		const auto castStart = cold->trace.active ? FlightRecorder::Ticks() : 0;
+		const auto projectile = GameState::GetEquippedProjectile(player);
+		const auto ballistic = config->crosshairBallisticAim && bowDrawn && projectile &&
+			projectile->data.gravity > 0.0f && projectile->data.speed > 0.0f;
+
+		cold->aimRay.length = GetAimRayLength(projectile, ballistic);
+		if (ballistic) {
+			// Follow the arc from the real launch angle rather than the fudged one above
+			// @Note: Draw strength and the per-arrow speed multipliers aren't known until release, assume a full draw
+			const auto launchDir = mmath::GetViewVector(
+				glm::vec3(0.0, 1.0, 0.0),
+				sim.currentBasis.pitch - launchTilt,
+				sim.currentBasis.yaw
+			);
+			cold->aimRay.pathPoints = mmath::BallisticPath(
+				static_cast<glm::vec3>(origin), launchDir,
+				projectile->data.speed, projectile->data.gravity * mmath::havokGravity,
+				cold->aimRay.length, maxAimSag, cold->aimRay.path.size() - 1, cold->aimRay.path.data()
+			);
+			cold->aimRay.result = Raycast::hkpCastPath(cold->aimRay.path.data(), cold->aimRay.pathPoints);
+		} else {
+			cold->aimRay.pathPoints = 0;
+			cold->aimRay.result = Raycast::hkpCastRay(origin, origin + glm::vec4(direction, 0.0f) * cold->aimRay.length);
+		}
+		cold->aimRay.origin = static_cast<glm::vec3>(origin);
+		cold->aimRay.direction = direction;
+		cold->aimRay.castTime = curTime;
+		cold->aimRay.valid = true;
+
+		cold->aimRay.hitCharacterHandle = 0;
+		if (cold->aimRay.result.hitCharacter) {
+			(*CreateRefHandleByREFR)(&cold->aimRay.hitCharacterHandle, cold->aimRay.result.hitCharacter);
+			const auto& pos = cold->aimRay.result.hitCharacter->pos;
+			cold->aimRay.hitCharacterPos = { pos.x, pos.y, pos.z };
+		}
+
+		if (cold->trace.active) {
+			cold->trace.record.zoneMicros[static_cast<size_t>(FlightRecorder::Zone::AimCast)] =
+				FlightRecorder::TicksToMicros(FlightRecorder::Ticks() - castStart);
+			cold->trace.record.flags |= FlightRecorder::AimRecast;
+		}
+	}
+	// The cached hit is reprojected below through this frame's worldToScreen
+	const auto& result = cold->aimRay.result;
+	const auto rayLength = cold->aimRay.length;
+	const auto ray = glm::vec4(direction, 0.0f) * rayLength;
 
 	auto port = NiRect<float>();
 	auto menu = MenuManager::GetSingleton()->GetMenu(&UIStringHolder::GetSingleton()->hudMenu);
@@ -726,15 +851,9 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 		port.m_bottom = rect.top;
 	}
 
-	glm::vec2 crosshairSize(baseCrosshairData.xScale, baseCrosshairData.yScale);
-	glm::vec2 crosshairPos(baseCrosshairData.xCenter, baseCrosshairData.yCenter);
+	glm::vec2 crosshairSize(cold->baseCrosshairData.xScale, cold->baseCrosshairData.yScale);
+	glm::vec2 crosshairPos(cold->baseCrosshairData.xCenter, cold->baseCrosshairData.yCenter);
 	if (result.hit) {
-		auto pt = NiPoint3(
-			result.hitPos.x,
-			result.hitPos.y,
-			result.hitPos.z
-		);
-
 		auto rangeScalar = glm::clamp((rayLength - result.rayLength) / rayLength, 0.0f, 1.0f);
 		auto sz = mmath::Remap(rangeScalar, 0.0f, 1.0f, config->crosshairMinDistSize, config->crosshairMaxDistSize);
 		crosshairSize = { sz, sz };
@@ -742,51 +861,113 @@ void Camera::SmoothCamera::UpdateCrosshairPosition(PlayerCharacter* player, cons
 		if (result.hitCharacter)
 			crosshairSize += config->crosshairNPCHitGrowSize * rangeScalar;
 
-		glm::vec3 screen = {};
-		(*WorldPtToScreenPt3_Internal)(
-			reinterpret_cast<float*>(worldToScreen.data),
-			&port, &pt,
-			&screen.x, &screen.y, &screen.z, 9.99999975e-06
-		);
+		glm::vec3 screen;
+		uint8_t visible;
+		const auto hitPos = static_cast<glm::vec3>(result.hitPos);
+		mmath::ProjectPoints(cold->worldToScreen, port, &hitPos, 1, &screen, &visible);
+#ifdef _DEBUG
+		if (camera->cameraNode->m_children.m_size != 0) {
+			const auto cameraNi = reinterpret_cast<NiCamera*>(camera->cameraNode->m_children.m_data[0]);
+			ProjectionCapture::Points(cameraNi, cold->worldToScreen, port, hitPos);
+		}
+#endif
 
-		crosshairPos = {
-			screen.x,
-			screen.y
-		};
+		if (visible) {
+			crosshairPos = {
+				screen.x,
+				screen.y
+			};
+		}
 	}
 
 #ifdef DEBUG_DRAWING
-	auto lineStart = mmath::PointToScreen(origin);
-	auto lineEnd = mmath::PointToScreen(result.hit ? result.hitPos : origin + ray);
-	DebugDrawing::Submit(DebugDrawing::DrawLine(lineStart, lineEnd, { 0.0f, 1.0f, 0.0f }));
+	if (cold->aimRay.pathPoints > 1) {
+		for (size_t i = 0; i + 1 < cold->aimRay.pathPoints; i++) {
+			auto lineStart = mmath::PointToScreen(cold->aimRay.path[i]);
+			auto lineEnd = mmath::PointToScreen(cold->aimRay.path[i + 1]);
+			DebugDrawing::Submit(DebugDrawing::DrawLine(lineStart, lineEnd, { 0.0f, 1.0f, 0.0f }));
+		}
+	} else {
+		auto lineStart = mmath::PointToScreen(origin);
+		auto lineEnd = mmath::PointToScreen(result.hit ? result.hitPos : origin + ray);
+		DebugDrawing::Submit(DebugDrawing::DrawLine(lineStart, lineEnd, { 0.0f, 1.0f, 0.0f }));
+	}
 #endif
 
+	if (cold->trace.active) {
+		cold->trace.record.crosshair[0] = crosshairPos.x;
+		cold->trace.record.crosshair[1] = crosshairPos.y;
+		if (result.hit) cold->trace.record.flags |= FlightRecorder::AimHit;
+		if (result.hitCharacter) cold->trace.record.flags |= FlightRecorder::AimHitCharacter;
+	}
+
 	SetCrosshairPosition(crosshairPos);
 	SetCrosshairSize(crosshairSize);
 }
 
+// Returns how far the aim ray should reach for the drawn bow, crossbow or spell
+// When following the arc, this is the distance flown along it
+float Camera::SmoothCamera::GetAimRayLength(const BGSProjectile* projectile, bool followArc) const noexcept {
+	// Beyond this drop below the line of aim, the crosshair would be lying about where an arrow lands
+	constexpr auto maxAimDrop = 128.0f;
+
+	const auto maxLength = glm::max(config->crosshairRayMaxLength, 1.0f);
+	if (!projectile) return maxLength;
+
+	auto length = projectile->data.range > 0.0f ? projectile->data.range : maxLength;
+	if (!followArc && projectile->data.gravity > 0.0f && projectile->data.speed > 0.0f) {
+		const auto dropTime = glm::sqrt(2.0f * maxAimDrop / (projectile->data.gravity * mmath::havokGravity));
+		length = glm::min(length, projectile->data.speed * dropTime);
+	}
+
+	return glm::clamp(length, 1.0f, maxLength);
+}
+
+// Returns true if the cached aim ray is stale and needs to be cast again
+bool Camera::SmoothCamera::ShouldRecastAimRay(const glm::vec3& origin, const glm::vec3& direction, double curTime) const noexcept {
+	// Roughly 0.1 degrees and a unit of movement - anything finer doesn't move the crosshair a pixel at full range
+	constexpr auto minDirectionDot = 0.9999985f;
+	constexpr auto maxOriginDistance2 = 1.0f;
+
+	if (!cold->aimRay.valid) return true;
+	// Keep the aim ray to the simulation rate too
+	if (config->fixedStepSimulation && !sim.fixedStep.stepped) return false;
+	if (curTime - cold->aimRay.castTime >= static_cast<double>(config->crosshairRayMaxInterval)) return true;
+	// A character that moved may have stepped off the ray, look it up by handle as it may be gone by now
+	if (cold->aimRay.hitCharacterHandle) {
+		auto handle = cold->aimRay.hitCharacterHandle;
+		NiPointer<TESObjectREFR> ref;
+		if (!(*LookupREFRByHandle)(handle, ref) || !ref) return true;
+		const auto pos = glm::vec3(ref->pos.x, ref->pos.y, ref->pos.z);
+		if (glm::distance2(pos, cold->aimRay.hitCharacterPos) > maxOriginDistance2) return true;
+	}
+	if (glm::distance2(origin, cold->aimRay.origin) > maxOriginDistance2) return true;
+	if (glm::dot(direction, cold->aimRay.direction) < minDirectionDot) return true;
+	return false;
+}
+
 void Camera::SmoothCamera::ReadInitialCrosshairInfo() {
 	auto menu = MenuManager::GetSingleton()->GetMenu(&UIStringHolder::GetSingleton()->hudMenu);
 	if (!menu || !menu->view) return;
 	
 	GFxValue va;
 	menu->view->GetVariable(&va, "_root.HUDMovieBaseInstance.CrosshairInstance._x");
-	baseCrosshairData.xOff = va.GetNumber();
+	cold->baseCrosshairData.xOff = va.GetNumber();
 
 	menu->view->GetVariable(&va, "_root.HUDMovieBaseInstance.CrosshairInstance._y");
-	baseCrosshairData.yOff = va.GetNumber();
+	cold->baseCrosshairData.yOff = va.GetNumber();
 
 	menu->view->GetVariable(&va, "_root.HUDMovieBaseInstance.CrosshairInstance._width");
-	baseCrosshairData.xScale = va.GetNumber();
+	cold->baseCrosshairData.xScale = va.GetNumber();
 
 	menu->view->GetVariable(&va, "_root.HUDMovieBaseInstance.CrosshairInstance._height");
-	baseCrosshairData.yScale = va.GetNumber();
+	cold->baseCrosshairData.yScale = va.GetNumber();
 
 	auto rect = menu->view->GetVisibleFrameRect();
-	baseCrosshairData.xCenter = mmath::Remap(0.5f, 0.0f, 1.0f, rect.left, rect.right);
-	baseCrosshairData.yCenter = mmath::Remap(0.5f, 0.0f, 1.0f, rect.top, rect.bottom);
+	cold->baseCrosshairData.xCenter = mmath::Remap(0.5f, 0.0f, 1.0f, rect.left, rect.right);
+	cold->baseCrosshairData.yCenter = mmath::Remap(0.5f, 0.0f, 1.0f, rect.top, rect.bottom);
 
-	baseCrosshairData.captured = true;
+	cold->baseCrosshairData.captured = true;
 }
 
 void Camera::SmoothCamera::SetCrosshairPosition(const glm::vec2& pos) const {
@@ -796,8 +977,8 @@ void Camera::SmoothCamera::SetCrosshairPosition(const glm::vec2& pos) const {
 		auto half_x = pos.x - ((rect.right + rect.left) * 0.5f);
 		auto half_y = pos.y - ((rect.bottom + rect.top) * 0.5f);
 		
-		auto x = static_cast<double>(half_x) + baseCrosshairData.xOff;
-		auto y = static_cast<double>(half_y) + baseCrosshairData.yOff;
+		auto x = static_cast<double>(half_x) + cold->baseCrosshairData.xOff;
+		auto y = static_cast<double>(half_y) + cold->baseCrosshairData.yOff;
 
 		GFxValue va;
 		va.SetNumber(x);
@@ -809,8 +990,8 @@ void Camera::SmoothCamera::SetCrosshairPosition(const glm::vec2& pos) const {
 
 void Camera::SmoothCamera::CenterCrosshair() const {
 	SetCrosshairPosition({
-		baseCrosshairData.xCenter,
-		baseCrosshairData.yCenter
+		cold->baseCrosshairData.xCenter,
+		cold->baseCrosshairData.yCenter
 	});
 }
 
@@ -844,22 +1025,25 @@ void Camera::SmoothCamera::UpdateInternalRotation(CorrectedPlayerCamera* camera)
 	const auto tps = reinterpret_cast<CorrectedThirdPersonState*>(camera->cameraState);
 	if (!tps) return;
 	tps->UpdateRotation();
-	currentQuat = glm::quat{ tps->rotation.m_fW, tps->rotation.m_fX, tps->rotation.m_fY, tps->rotation.m_fZ };
+	sim.currentQuat = glm::quat{ tps->rotation.m_fW, tps->rotation.m_fX, tps->rotation.m_fY, tps->rotation.m_fZ };
+
+	const auto pitch = glm::pitch(sim.currentQuat);
+	const auto yaw = glm::roll(sim.currentQuat);
+	sim.currentRotation.x = pitch *-1;
+	sim.currentRotation.y = yaw *-1;
 
-	const auto pitch = glm::pitch(currentQuat);
-	const auto yaw = glm::roll(currentQuat);
-	currentRotation.x = pitch *-1;
-	currentRotation.y = yaw *-1;
+	// Everything else that needs the rotation this frame reads from here
+	sim.currentBasis = mmath::ComputeCameraBasis(sim.currentRotation.x, sim.currentRotation.y);
 }
 
 // Returns the camera's pitch
 float Camera::SmoothCamera::GetCameraPitchRotation(const CorrectedPlayerCamera* camera) const noexcept {
-	return currentRotation.x;
+	return sim.currentRotation.x;
 }
 
 // Returns the camera's yaw
 float Camera::SmoothCamera::GetCameraYawRotation(const CorrectedPlayerCamera* camera) const noexcept {
-	return currentRotation.y;
+	return sim.currentRotation.y;
 }
 
 // Returns the camera's current zoom level - Camera must extend ThirdPersonState
@@ -880,7 +1064,7 @@ void Camera::SmoothCamera::PreGameUpdate(PlayerCharacter* player, CorrectedPlaye
 		camera->cameraNode->m_children.m_data[0]
 	);
 	if (cameraNi)
-		gameLastActualPosition = {
+		sim.gameLastActualPosition = {
 			cameraNi->m_worldTransform.pos.x,
 			cameraNi->m_worldTransform.pos.y,
 			cameraNi->m_worldTransform.pos.z
@@ -896,14 +1080,20 @@ void Camera::SmoothCamera::UpdateCamera(PlayerCharacter* player, CorrectedPlayer
 	Profiler prof;
 #endif;
 
-	if (!baseCrosshairData.captured) {
+	if (!cold->baseCrosshairData.captured) {
 		ReadInitialCrosshairInfo();
 	}
 
 	auto cameraNode = camera->cameraNode;
 	config = Config::GetCurrentConfig();
+	AsyncLog::SetDebugEnabled(config->enableDebugLogging);
+	BeginFrameTrace();
+	if (cold->offsetTableRevision != Config::GetConfigRevision())
+		RebuildOffsetTable();
+
+	ProcessInputQueue();
 
-	gameInitialWorldPosition = {
+	sim.gameInitialWorldPosition = {
 		cameraNode->m_worldTransform.pos.x,
 		cameraNode->m_worldTransform.pos.y,
 		cameraNode->m_worldTransform.pos.z
@@ -913,65 +1103,66 @@ void Camera::SmoothCamera::UpdateCamera(PlayerCharacter* player, CorrectedPlayer
 	const auto pov = UpdateCameraPOVState(player, camera);
 	const auto state = GetCurrentCameraState(player, camera);
 	const auto actionState = GetCurrentCameraActionState(player, camera);
-	offsetState.currentGroup = GetOffsetForState(actionState);
-	const auto currentOffset = GetCurrentCameraOffset(player, camera);
+	const auto stance = GetCurrentWeaponStance(player);
+	offsetState.current = &cold->offsetTable
+		[static_cast<size_t>(actionState)]
+		[static_cast<size_t>(stance)]
+		[state == GameState::CameraState::Horseback ? 1 : 0];
+	const auto currentOffset = GetCurrentCameraOffset(camera);
 	const auto curTime = CurTime();
 
 	// Perform a bit of setup to smooth out camera loading
 	if (!firstFrame) {
-		lastPosition = lastWorldPosition = currentPosition = gameInitialWorldPosition;
+		sim.lastPosition = sim.lastWorldPosition = sim.currentPosition = sim.gameInitialWorldPosition;
+		sim.springVelocity = glm::vec4(0.0f);
 		firstFrame = true;
 	}
 
 	// Update transition states
-	UpdateTransitionState<glm::vec2, OffsetTransition>(
-		curTime,
-		config->enableOffsetInterpolation,
-		config->offsetInterpDurationSecs,
-		config->offsetScalar,
-		offsetTransitionState,
-		{ currentOffset.x, currentOffset.z }
-	);
-
-	if (!povWasPressed) {
-		UpdateTransitionState<float, ZoomTransition>(
-			curTime,
-			config->enableZoomInterpolation,
-			config->zoomInterpDurationSecs,
-			config->zoomScalar,
-			zoomTransitionState,
-			currentOffset.y
-			);
-	} else {
-		zoomTransitionState.lastPosition = zoomTransitionState.currentPosition =
-			zoomTransitionState.targetPosition = currentOffset.y;
-	}
-	offsetState.position = {
-		offsetTransitionState.currentPosition.x,
-		zoomTransitionState.currentPosition,
-		offsetTransitionState.currentPosition.y
+	constexpr auto side = static_cast<size_t>(TransitionChannel::Side);
+	constexpr auto up = static_cast<size_t>(TransitionChannel::Up);
+	constexpr auto zoom = static_cast<size_t>(TransitionChannel::Zoom);
+	sim.transitions.Configure(side, config->enableOffsetInterpolation, config->offsetInterpDurationSecs, config->offsetScalar);
+	sim.transitions.Configure(up, config->enableOffsetInterpolation, config->offsetInterpDurationSecs, config->offsetScalar);
+	sim.transitions.Configure(zoom, config->enableZoomInterpolation, config->zoomInterpDurationSecs, config->zoomScalar);
+
+	sim.transitions.SetTarget(side, currentOffset.x, curTime);
+	sim.transitions.SetTarget(up, currentOffset.z, curTime);
+	if (!cold->povWasPressed)
+		sim.transitions.SetTarget(zoom, currentOffset.y, curTime);
+	else
+		sim.transitions.Snap(zoom, currentOffset.y);
+	sim.transitions.Update(curTime);
+
+	sim.offsetPosition = {
+		sim.transitions.Get(side),
+		sim.transitions.Get(zoom),
+		sim.transitions.Get(up)
 	};
 
 	// Save the camera position
-	lastPosition = currentPosition;
+	sim.lastPosition = sim.currentPosition;
+	EndTraceZone(FlightRecorder::Zone::Setup);
 
-	if (config->disableDuringDialog && dialogMenuOpen) {
-		lastPosition = lastWorldPosition = currentPosition = gameInitialWorldPosition;
+	if (config->disableDuringDialog && cold->dialogMenuOpen) {
+		sim.lastPosition = sim.lastWorldPosition = sim.currentPosition = sim.gameInitialWorldPosition;
+		sim.springVelocity = glm::vec4(0.0f);
+		sim.fixedStep.valid = false;
 	} else {
 		switch (state) {
 			case GameState::CameraState::ThirdPerson: {
 				UpdateInternalRotation(camera);
-				cameraStates.at(static_cast<size_t>(GameState::CameraState::ThirdPerson))->Update(player, camera);
+				RunCameraState(cameraStates.at(static_cast<size_t>(GameState::CameraState::ThirdPerson)).get(), player, camera);
 				break;
 			}
 			case GameState::CameraState::ThirdPersonCombat: {
 				UpdateInternalRotation(camera);
-				cameraStates.at(static_cast<size_t>(GameState::CameraState::ThirdPersonCombat))->Update(player, camera);
+				RunCameraState(cameraStates.at(static_cast<size_t>(GameState::CameraState::ThirdPersonCombat)).get(), player, camera);
 				break;
 			}
 			case GameState::CameraState::Horseback: {
 				UpdateInternalRotation(camera);
-				cameraStates.at(static_cast<size_t>(GameState::CameraState::Horseback))->Update(player, camera);
+				RunCameraState(cameraStates.at(static_cast<size_t>(GameState::CameraState::Horseback)).get(), player, camera);
 				break;
 			}
 
@@ -992,14 +1183,18 @@ void Camera::SmoothCamera::UpdateCamera(PlayerCharacter* player, CorrectedPlayer
 			{
 				SetCrosshairEnabled(true);
 				CenterCrosshair();
-				SetCrosshairSize({ baseCrosshairData.xScale, baseCrosshairData.yScale });
-				lastPosition = lastWorldPosition = currentPosition = gameInitialWorldPosition;
+				SetCrosshairSize({ cold->baseCrosshairData.xScale, cold->baseCrosshairData.yScale });
+				sim.lastPosition = sim.lastWorldPosition = sim.currentPosition = sim.gameInitialWorldPosition;
+				sim.springVelocity = glm::vec4(0.0f);
+				sim.fixedStep.valid = false;
 				break;
 			}
 		}
 	}
 
-	povWasPressed = false;
+	cold->povWasPressed = false;
+	EndTraceZone(FlightRecorder::Zone::State);
+	EndFrameTrace(state, actionState, stance);
 
 #ifdef _DEBUG
 	auto snap = prof.Snap();
@@ -17,8 +17,8 @@ Camera::CameraActionState Camera::State::BaseCameraState::GetCameraActionState()
 }
 
 // Returns the position of the camera during the last frame
-glm::vec3 Camera::State::BaseCameraState::GetLastCameraPosition() const noexcept {
-	return camera->lastPosition;
+glm::vec3 Camera::State::BaseCameraState::GetLastCameraPosition(const SimulationState& sim) const noexcept {
+	return sim.lastPosition;
 }
 
 // Sets the camera position
@@ -26,15 +26,33 @@ void Camera::State::BaseCameraState::SetCameraPosition(const glm::vec3& pos, con
 	camera->SetPosition(pos, playerCamera);
 }
 
+// Places the camera at a position blended between fixed-step updates, without running the camera model
+void Camera::State::BaseCameraState::Present(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera,
+	SimulationState& sim, const glm::vec3& pos, const glm::vec3& localPos)
+{
+	SetCameraPosition(pos, playerCamera);
+	ApplyLocalSpaceGameOffsets(sim, localPos, GetCameraBasis(sim), player, playerCamera);
+	UpdateCrosshair(sim, player, playerCamera);
+}
+
 // Performs a ray cast and returns a new position based on the result
 glm::vec3 Camera::State::BaseCameraState::ComputeRaycast(const glm::vec3& rayStart, const glm::vec3& rayEnd) {
 	constexpr float hullSize = 15.0f;
 	const auto rayStart4 = glm::vec4(rayStart.x, rayStart.y, rayStart.z, 0.0f);
 	const auto rayEnd4 = glm::vec4(rayEnd.x, rayEnd.y, rayEnd.z, 0.0f);
 	const auto result = Raycast::CastRay(rayStart4, rayEnd4, hullSize);
-	return result.hit ?
+	const auto pos = result.hit ?
 		result.hitPos + (result.rayNormal * glm::min(result.rayLength, hullSize)) :
 		rayEnd;
+
+	auto& trace = camera->cold->trace;
+	if (trace.active) {
+		FlightRecorder::Store(trace.record.preClamp, rayEnd);
+		FlightRecorder::Store(trace.record.postClamp, pos);
+		trace.record.rayLength = result.hit ? result.rayLength : glm::length(rayEnd - rayStart);
+		if (result.hit) trace.record.flags |= FlightRecorder::CollisionHit;
+	}
+	return pos;
 }
 
 // Clamps the camera position based on offset clamp settings
@@ -43,7 +61,6 @@ glm::vec3 Camera::State::BaseCameraState::ComputeOffsetClamping(PlayerCharacter*
 {
 	const auto local = cameraLocalOffset;
 	const auto target = cameraWorldTarget;
-	const auto matView = camera->GetViewMatrix(player, playerCamera);
 
 	// This is the position we ideally want to be in, before interpolation
 	const auto expectedPosition = target + static_cast<glm::vec3>(local);
@@ -97,7 +114,12 @@ glm::vec3 Camera::State::BaseCameraState::ComputeOffsetClamping(PlayerCharacter*
 	return (forward * coef.x) + (right * coef.y) + (up * coef.z) + cameraWorldTarget/* + expectedPosition*/;
 }
 
-void Camera::State::BaseCameraState::UpdateCrosshair(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const {
+void Camera::State::BaseCameraState::UpdateCrosshair(const SimulationState& sim, PlayerCharacter* player,
+	const CorrectedPlayerCamera* playerCamera) const
+{
+	// Fixed-step updates aren't where the camera ends up this frame, the crosshair is placed when we present
+	if (sim.fixedStep.stepping) return;
+
 	auto use3D = false;
 	if (GameState::IsRangedWeaponDrawn(player)) {
 		use3D = GameState::IsBowDrawn(player) && GetConfig()->use3DBowAimCrosshair;
@@ -115,7 +137,7 @@ void Camera::State::BaseCameraState::UpdateCrosshair(PlayerCharacter* player, co
 				UpdateCrosshairPosition(player, playerCamera);
 			} else {
 				CenterCrosshair();
-				camera->SetCrosshairSize({ camera->baseCrosshairData.xScale, camera->baseCrosshairData.yScale });
+				camera->SetCrosshairSize({ camera->cold->baseCrosshairData.xScale, camera->cold->baseCrosshairData.yScale });
 			}
 		}
 	} else {
@@ -124,7 +146,7 @@ void Camera::State::BaseCameraState::UpdateCrosshair(PlayerCharacter* player, co
 		} else {
 			SetCrosshairEnabled(true);
 			CenterCrosshair();
-			camera->SetCrosshairSize({ camera->baseCrosshairData.xScale, camera->baseCrosshairData.yScale });
+			camera->SetCrosshairSize({ camera->cold->baseCrosshairData.xScale, camera->cold->baseCrosshairData.yScale });
 		}
 	}
 }
@@ -148,111 +170,115 @@ void Camera::State::BaseCameraState::SetCrosshairEnabled(bool enabled) const {
 	camera->SetCrosshairEnabled(enabled);
 }
 
-// Returns a rotation matrix to use with rotating the camera
-glm::mat4 Camera::State::BaseCameraState::GetViewMatrix(const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const noexcept {
-	return camera->GetViewMatrix(player, playerCamera);
+// Returns the camera basis computed for this frame
+const mmath::CameraBasis& Camera::State::BaseCameraState::GetCameraBasis(const SimulationState& sim) const noexcept {
+	return sim.currentBasis;
 }
 
 // Returns the euler rotation of the camera
-glm::vec2 Camera::State::BaseCameraState::GetCameraRotation(const CorrectedPlayerCamera* playerCamera) const noexcept {
-	return {
-		camera->GetCameraPitchRotation(playerCamera),
-		camera->GetCameraYawRotation(playerCamera)
-	};
+glm::vec2 Camera::State::BaseCameraState::GetCameraRotation(const SimulationState& sim) const noexcept {
+	return sim.currentRotation;
 }
 
 // Returns the local offsets to apply to the camera
-glm::vec3 Camera::State::BaseCameraState::GetCameraLocalPosition(PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const noexcept {
-	//return camera->GetCurrentCameraOffset(player, playerCamera);
-	return camera->offsetState.position;
+glm::vec3 Camera::State::BaseCameraState::GetCameraLocalPosition(const SimulationState& sim) const noexcept {
+	return sim.offsetPosition;
 }
 
 // Returns the world position to apply local offsets to
 glm::vec3 Camera::State::BaseCameraState::GetCameraWorldPosition(const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera) const {
-	return camera->GetCurrentCameraTargetWorldPosition(player, playerCamera);
+	const auto target = camera->GetCurrentCameraTargetWorldPosition(player, playerCamera);
+	// Noted for the flight recorder
+	if (camera->cold->trace.active)
+		FlightRecorder::Store(camera->cold->trace.record.target, target);
+	return target;
 }
 
 // Performs all camera offset math using the view rotation matrix and local offsets, returns a local position
-glm::vec3 Camera::State::BaseCameraState::GetTransformedCameraLocalPosition(PlayerCharacter* player,
-	const CorrectedPlayerCamera* playerCamera) const
+glm::vec3 Camera::State::BaseCameraState::GetTransformedCameraLocalPosition(const SimulationState& sim,
+	const mmath::CameraBasis& basis) const
 {
-	const auto cameraLocal = GetCameraLocalPosition(player, playerCamera);
-	auto translated = camera->GetViewMatrix(player, playerCamera) * glm::vec4(
-		cameraLocal.x,
-		cameraLocal.y,
-		0.0f,
-		1.0f
-	);
-	translated.z += cameraLocal.z;
-	return static_cast<glm::vec3>(translated);
+	return mmath::TransformLocalOffset(GetCameraLocalPosition(sim), basis);
 }
 
 // Interpolates the given position
-glm::vec3 Camera::State::BaseCameraState::UpdateInterpolatedLocalPosition(PlayerCharacter* player, const glm::vec3& rot) {
-	if (camera->lastLocalPosition == glm::vec3(0.0f)) {
+glm::vec3 Camera::State::BaseCameraState::UpdateInterpolatedLocalPosition(SimulationState& sim, const glm::vec3& rot) {
+	if (sim.lastLocalPosition == glm::vec3(0.0f)) {
 		// Store the first valid position for future interpolation
-		StoreLastLocalPosition(rot);
+		StoreLastLocalPosition(sim, rot);
 		return rot;
 	}
 	
 	const auto pos = mmath::Interpolate<glm::dvec3, double>(
-		camera->lastLocalPosition, rot, camera->GetCurrentSmoothingScalar(
+		sim.lastLocalPosition, rot, camera->GetCurrentSmoothingScalar(
+			sim,
 			camera->config->localScalarRate,
 			ScalarSelector::LocalSpace
 		)
 	);
-	StoreLastLocalPosition(static_cast<glm::vec3>(pos));
+	StoreLastLocalPosition(sim, static_cast<glm::vec3>(pos));
 	return pos;
 }
 
 // Interpolates the given position, stores last interpolated position
-glm::vec3 Camera::State::BaseCameraState::UpdateInterpolatedWorldPosition(PlayerCharacter* player, const glm::vec3& pos, const float distance) {
+glm::vec3 Camera::State::BaseCameraState::UpdateInterpolatedWorldPosition(SimulationState& sim, const glm::vec3& pos,
+	const float distance)
+{
 	if (!GetConfig()->enableInterp) {
 		return pos;
 	}
 
-	if (!camera->IsInterpAllowed(player)) {
+	if (!camera->IsInterpAllowed()) {
+		sim.springVelocity = glm::vec4(0.0f);
 		return pos;
 	}
 
+	if (GetConfig()->springInterp) {
+		auto position = glm::vec4(sim.lastWorldPosition, 0.0f);
+		mmath::CriticalSpring(
+			position, sim.springVelocity, glm::vec4(pos, 0.0f),
+			2.0f / glm::max(GetConfig()->springSmoothTimeXY, 0.01f),
+			2.0f / glm::max(GetConfig()->springSmoothTimeZ, 0.01f),
+			static_cast<float>(SmoothCamera::GetSimulationDelta(sim))
+		);
+		return static_cast<glm::vec3>(position);
+	}
+
 	if (GetConfig()->separateZInterp) {
 		const auto xy = mmath::Interpolate<glm::dvec3, double>(
-			camera->lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(distance)
+			sim.lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(sim, distance)
 		);
 
 		const auto z = mmath::Interpolate<glm::dvec3, double>(
-			camera->lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(distance, ScalarSelector::SepZ)
+			sim.lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(sim, distance, ScalarSelector::SepZ)
 		);
 
 		return { xy.x, xy.y, z.z };
 
 	} else {
 		const auto ret = mmath::Interpolate<glm::dvec3, double>(
-			camera->lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(distance)
+			sim.lastWorldPosition, pos, camera->GetCurrentSmoothingScalar(sim, distance)
 		);
 		return static_cast<glm::vec3>(ret);
 	}
 }
 
-void Camera::State::BaseCameraState::ApplyLocalSpaceGameOffsets(const glm::vec3& pos, const PlayerCharacter* player,
-	const CorrectedPlayerCamera* playerCamera)
+void Camera::State::BaseCameraState::ApplyLocalSpaceGameOffsets(SimulationState& sim, const glm::vec3& pos,
+	const mmath::CameraBasis& basis, const PlayerCharacter* player, const CorrectedPlayerCamera* playerCamera)
 {
+	sim.fixedStep.appliedLocalOffset = pos;
+	// Fixed-step updates only advance the simulation, the offsets are handed to the game when we present
+	if (sim.fixedStep.stepping) return;
+
 	auto state = reinterpret_cast<CorrectedThirdPersonState*>(playerCamera->cameraState);
-	const auto rot = GetCameraRotation(playerCamera);
-	glm::vec3 forward, right, up, coef;
-	mmath::DecomposeToBasis(
-		pos,
-		{ rot.x, 0.0f, rot.y },
-		forward, right, up, coef
-	);
+	const auto coef = mmath::DecomposeToBasis(pos, basis);
 
-	auto view = glm::quat_cast(GetViewMatrix(player, playerCamera));
-	state->rotation.m_fW = view.w;
-	state->rotation.m_fX = view.x;
-	state->rotation.m_fY = view.y;
-	state->rotation.m_fZ = view.z;
-	state->yaw1 = rot.y;
-	state->yaw2 = rot.y;
+	state->rotation.m_fW = basis.quat.w;
+	state->rotation.m_fX = basis.quat.x;
+	state->rotation.m_fY = basis.quat.y;
+	state->rotation.m_fZ = basis.quat.z;
+	state->yaw1 = basis.yaw;
+	state->yaw2 = basis.yaw;
 
 	if (GetCameraState() == GameState::CameraState::ThirdPersonCombat && GameState::IsBowDrawn(player)) {
 		state->fOverShoulderPosX = 0.0f;
@@ -269,20 +295,20 @@ void Camera::State::BaseCameraState::ApplyLocalSpaceGameOffsets(const glm::vec3&
 	state->offsetVector.z = state->fOverShoulderPosZ;
 }
 
-void Camera::State::BaseCameraState::StoreLastLocalPosition(const glm::vec3& pos) {
-	camera->lastLocalPosition = pos;
+void Camera::State::BaseCameraState::StoreLastLocalPosition(SimulationState& sim, const glm::vec3& pos) {
+	sim.lastLocalPosition = pos;
 }
 
-void Camera::State::BaseCameraState::StoreLastWorldPosition(const glm::vec3& pos) {
-	camera->lastWorldPosition = pos;
+void Camera::State::BaseCameraState::StoreLastWorldPosition(SimulationState& sim, const glm::vec3& pos) {
+	sim.lastWorldPosition = pos;
 }
 
-glm::vec3 Camera::State::BaseCameraState::GetLastLocalPosition() {
-	return camera->lastLocalPosition;
+glm::vec3 Camera::State::BaseCameraState::GetLastLocalPosition(const SimulationState& sim) const noexcept {
+	return sim.lastLocalPosition;
 }
 
-glm::vec3 Camera::State::BaseCameraState::GetLastWorldPosition() {
-	return camera->lastWorldPosition;
+glm::vec3 Camera::State::BaseCameraState::GetLastWorldPosition(const SimulationState& sim) const noexcept {
+	return sim.lastWorldPosition;
 }
 
 // Returns true if the player is moving
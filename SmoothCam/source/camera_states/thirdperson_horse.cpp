@@ -13,13 +13,17 @@ void Camera::State::ThirdpersonHorseState::OnEnd(const PlayerCharacter* player,
 
 }
 
-void Camera::State::ThirdpersonHorseState::Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera) {
+void Camera::State::ThirdpersonHorseState::Update(PlayerCharacter* player, const CorrectedPlayerCamera* camera,
+	SimulationState& sim)
+{
+	// Get the rotation basis computed for this frame
+	const auto& basis = GetCameraBasis(sim);
 	// Get our computed local-space xyz offset.
-	const auto cameraLocal = GetCameraLocalPosition(player, camera);
+	const auto cameraLocal = GetCameraLocalPosition(sim);
 	// Get the base world position for the camera which we will offset with the local-space values.
 	const auto worldTarget = GetCameraWorldPosition(player, camera);
 	// Transform the camera offsets based on the computed view matrix
-	const auto transformedLocalPos = GetTransformedCameraLocalPosition(player, camera);
+	const auto transformedLocalPos = GetTransformedCameraLocalPosition(sim, basis);
 	// Define the starting point for our raycast
 	const auto start = worldTarget + glm::vec3(0.0f, 0.0f, cameraLocal.z);
 
@@ -29,12 +33,12 @@ void Camera::State::ThirdpersonHorseState::Update(PlayerCharacter* player, const
 		// Handle separate local-space interpolation
 
 		// Interpolate the local position (rotation and translation offsets)
-		localPos = UpdateInterpolatedLocalPosition(player, transformedLocalPos);
+		localPos = UpdateInterpolatedLocalPosition(sim, transformedLocalPos);
 		// And the world target
-		const auto lerpedWorldPos = UpdateInterpolatedWorldPosition(player, worldTarget, glm::length(GetLastWorldPosition() - worldTarget));
+		const auto lerpedWorldPos = UpdateInterpolatedWorldPosition(sim, worldTarget, glm::length(GetLastWorldPosition(sim) - worldTarget));
 		// Compute offset clamping if enabled
 		const auto clampedWorldPos = ComputeOffsetClamping(player, start, lerpedWorldPos);
-		StoreLastWorldPosition(clampedWorldPos);
+		StoreLastWorldPosition(sim, clampedWorldPos);
 
 		// Construct the final position
 		preFinalPos = clampedWorldPos + localPos;
@@ -44,10 +48,10 @@ void Camera::State::ThirdpersonHorseState::Update(PlayerCharacter* player, const
 		// Add the final local space transformation to the player postion
 		const auto targetWorldPos = worldTarget + transformedLocalPos;
 		// Now lerp it based on camera distance to player position
-		const auto lerpedWorldPos = UpdateInterpolatedWorldPosition(player, targetWorldPos, glm::length(targetWorldPos - worldTarget));
+		const auto lerpedWorldPos = UpdateInterpolatedWorldPosition(sim, targetWorldPos, glm::length(targetWorldPos - worldTarget));
 		// Compute offset clamping if enabled
 		preFinalPos = ComputeOffsetClamping(player, camera, transformedLocalPos, worldTarget, lerpedWorldPos);
-		StoreLastWorldPosition(preFinalPos);
+		StoreLastWorldPosition(sim, preFinalPos);
 		localPos = lerpedWorldPos - worldTarget;
 	}
 
@@ -57,8 +61,8 @@ void Camera::State::ThirdpersonHorseState::Update(PlayerCharacter* player, const
 	SetCameraPosition(finalPos, camera);
 
 	// Feed our local position offsets to the game camera state for correct crosshair alignment
-	ApplyLocalSpaceGameOffsets(localPos, player, camera);
+	ApplyLocalSpaceGameOffsets(sim, localPos, basis, player, camera);
 
 	// Update crosshair
-	UpdateCrosshair(player, camera);
+	UpdateCrosshair(sim, player, camera);
 }
\ No newline at end of file
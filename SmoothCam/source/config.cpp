@@ -1,5 +1,6 @@
 Config::UserConfig currentConfig;
 Config::GameConfig gameConfig;
+uint32_t configRevision = 0;
 
 #define CREATE_JSON_VALUE(obj, member) {#member, obj.member}
 #define VALUE_FROM_JSON(obj, member)	\
@@ -67,7 +68,14 @@ void Config::to_json(json& j, const UserConfig& obj) {
 		CREATE_JSON_VALUE(obj, crosshairNPCHitGrowSize),
 		CREATE_JSON_VALUE(obj, crosshairMinDistSize),
 		CREATE_JSON_VALUE(obj, crosshairMaxDistSize),
+		CREATE_JSON_VALUE(obj, crosshairRayMaxInterval),
+		CREATE_JSON_VALUE(obj, crosshairRayMaxLength),
+		CREATE_JSON_VALUE(obj, crosshairBallisticAim),
 		CREATE_JSON_VALUE(obj, disableDeltaTime),
+		CREATE_JSON_VALUE(obj, fixedStepSimulation),
+		CREATE_JSON_VALUE(obj, fixedStepRate),
+		CREATE_JSON_VALUE(obj, enableFlightRecorder),
+		CREATE_JSON_VALUE(obj, enableDebugLogging),
 		CREATE_JSON_VALUE(obj, shoulderSwapKey),
 		CREATE_JSON_VALUE(obj, swapXClamping),
 		CREATE_JSON_VALUE(obj, disableDuringDialog),
@@ -81,6 +89,9 @@ void Config::to_json(json& j, const UserConfig& obj) {
 		CREATE_JSON_VALUE(obj, maxCameraFollowRate),
 		CREATE_JSON_VALUE(obj, zoomMul),
 		CREATE_JSON_VALUE(obj, zoomMaxSmoothingDistance),
+		CREATE_JSON_VALUE(obj, springInterp),
+		CREATE_JSON_VALUE(obj, springSmoothTimeXY),
+		CREATE_JSON_VALUE(obj, springSmoothTimeZ),
 		CREATE_JSON_VALUE(obj, separateLocalInterp),
 		CREATE_JSON_VALUE(obj, separateLocalScalar),
 		CREATE_JSON_VALUE(obj, localScalarRate),
@@ -127,7 +138,14 @@ void Config::from_json(const json& j, UserConfig& obj) {
 	VALUE_FROM_JSON(obj, crosshairNPCHitGrowSize)
 	VALUE_FROM_JSON(obj, crosshairMinDistSize)
 	VALUE_FROM_JSON(obj, crosshairMaxDistSize)
+	VALUE_FROM_JSON(obj, crosshairRayMaxInterval)
+	VALUE_FROM_JSON(obj, crosshairRayMaxLength)
+	VALUE_FROM_JSON(obj, crosshairBallisticAim)
 	VALUE_FROM_JSON(obj, disableDeltaTime)
+	VALUE_FROM_JSON(obj, fixedStepSimulation)
+	VALUE_FROM_JSON(obj, fixedStepRate)
+	VALUE_FROM_JSON(obj, enableFlightRecorder)
+	VALUE_FROM_JSON(obj, enableDebugLogging)
 	VALUE_FROM_JSON(obj, shoulderSwapKey)
 	VALUE_FROM_JSON(obj, swapXClamping)
 	VALUE_FROM_JSON(obj, disableDuringDialog)
@@ -141,6 +159,9 @@ void Config::from_json(const json& j, UserConfig& obj) {
 	VALUE_FROM_JSON(obj, maxCameraFollowRate)
 	VALUE_FROM_JSON(obj, zoomMul)
 	VALUE_FROM_JSON(obj, zoomMaxSmoothingDistance)
+	VALUE_FROM_JSON(obj, springInterp)
+	VALUE_FROM_JSON(obj, springSmoothTimeXY)
+	VALUE_FROM_JSON(obj, springSmoothTimeZ)
 	VALUE_FROM_JSON(obj, separateLocalInterp)
 	VALUE_FROM_JSON(obj, separateLocalScalar)
 	VALUE_FROM_JSON(obj, localScalarRate)
@@ -200,7 +221,7 @@ void Config::ReadConfigFile() {
 		} catch (std::exception& e) {
 			// Welp, something broke
 			// Save the default config
-			_WARNING("%s - %s", "Failed to load user config! Loading Defaults. Error message:", e.what());
+			LOG_WARNING("%s - %s", "Failed to load user config! Loading Defaults. Error message:", e.what());
 			SaveCurrentConfig();
 		}
 	} else {
@@ -210,7 +231,7 @@ void Config::ReadConfigFile() {
 
 	wchar_t path[MAX_PATH];
 	if (!SUCCEEDED(SHGetFolderPath(NULL, CSIDL_PERSONAL, NULL, SHGFP_TYPE_CURRENT, path))) {
-		_WARNING("Failed to locate My Documents folder, using defualt game config values.");
+		LOG_WARNING("Failed to locate My Documents folder, using defualt game config values.");
 	} else {
 		wchar_t buf[16];
 		const auto inipath = std::wstring(path) + L"\\My Games\\Skyrim Special Edition\\Skyrim.ini";
@@ -236,9 +257,13 @@ void Config::ReadConfigFile() {
 	}
 
 	currentConfig = cfg;
+	configRevision++;
 }
 
 void Config::SaveCurrentConfig() {
+	// All config edits are followed by a save, let anything caching config values know
+	configRevision++;
+
 	std::ofstream os(L"Data/SKSE/Plugins/SmoothCam.json");
 	Config::json j = currentConfig;
 	os << j << std::endl;
@@ -248,6 +273,10 @@ Config::UserConfig* Config::GetCurrentConfig() noexcept {
 	return &currentConfig;
 }
 
+uint32_t Config::GetConfigRevision() noexcept {
+	return configRevision;
+}
+
 void Config::ResetConfig() {
 	currentConfig = {};
 	SaveCurrentConfig();
@@ -282,7 +311,7 @@ bool Config::LoadPreset(int slot) {
 		} catch (std::exception& e) {
 			// Welp, something broke
 			// Save the default config
-			_WARNING("%s <%d> %s", "Failed to load preset config! Error message:", slot, e.what());
+			LOG_WARNING("%s <%d> %s", "Failed to load preset config! Error message:", slot, e.what());
 			return false;
 		}
 	} else {
@@ -307,7 +336,7 @@ Config::LoadStatus Config::LoadPresetName(int slot, std::string& name) {
 		} catch (std::exception& e) {
 			// Welp, something broke
 			// Save the default config
-			_WARNING("%s <%d> %s", "Failed to load preset config! Error message:", slot, e.what());
+			LOG_WARNING("%s <%d> %s", "Failed to load preset config! Error message:", slot, e.what());
 			return LoadStatus::FAILED;
 		}
 	} else {
@@ -15,11 +15,8 @@ typedef struct {
 TempD3DResources tempD3DResources;
 
 DebugDrawing::D3DObjects obj;
-DebugDrawing::CommandQueue commandQueue;
-struct {
-	std::unique_ptr<DebugDrawing::LineDrawer> line;
-	std::unique_ptr<DebugDrawing::BoxDrawer> box;
-} drawers;
+DebugDrawing::CommandArena commandArena;
+std::unique_ptr<DebugDrawing::LineBatcher> lineBatcher;
 
 constexpr const auto drawLineVS = R"(
 struct VS_INPUT {
@@ -175,41 +172,97 @@ void DebugDrawing::DetourD3D11() {
 		);
 
 		if (!d3dHook2.hook()) {
-			_ERROR("Failed to place detour on target virtual function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target virtual function, this error is fatal.");
 			FatalError(L"Failed to place detour on target virtual function, this error is fatal.");
 		}
 	}
 }
 #pragma endregion
 
-DebugDrawing::CommandQueue* DebugDrawing::GetCommandQueue() {
-	return &commandQueue;
+DebugDrawing::CommandArena* DebugDrawing::GetCommandArena() {
+	return &commandArena;
+}
+
+// Copies a command into the current write buffer, returning false if it was full
+bool DebugDrawing::WriteCommand(CommandType type, const void* cmd, size_t size) {
+	// Keep every record 16 byte aligned
+	const auto stride = (sizeof(CommandHeader) + size + 15) & ~static_cast<size_t>(15);
+
+	// Register as a writer, then make sure Present didn't swap buffers out from under us
+	CommandBuffer* buffer;
+	while (true) {
+		const auto index = commandArena.writeIndex.load();
+		buffer = &commandArena.buffers[index];
+		buffer->writers++;
+		if (commandArena.writeIndex.load() == index) break;
+		buffer->writers--;
+	}
+
+	const auto offset = buffer->head.fetch_add(stride);
+	const auto fits = offset + stride <= CommandBuffer::Capacity;
+	if (fits) {
+		auto header = reinterpret_cast<CommandHeader*>(buffer->data + offset);
+		header->type = type;
+		header->stride = static_cast<uint32_t>(stride);
+		memcpy(buffer->data + offset + sizeof(CommandHeader), cmd, size);
+	} else {
+		// The first record to not fit ends the buffer - records are 16 byte aligned so a header always fits
+		if (offset < CommandBuffer::Capacity) {
+			auto header = reinterpret_cast<CommandHeader*>(buffer->data + offset);
+			header->type = CommandType::None;
+			header->stride = 0;
+		}
+		buffer->dropped++;
+	}
+
+	buffer->writers--;
+	return fits;
 }
 
 bool DebugDrawing::DrawingEnabled() { return drawingEnabled;  }
 void DebugDrawing::SetDrawingEnabled(bool enable) { drawingEnabled = enable; }
 
 void DebugDrawing::Flush() {
-	std::lock_guard<std::mutex> lock(commandQueue.lock);
+	// Point new submits at the other buffer, then wait out anyone still writing to this one
+	const auto readIndex = commandArena.writeIndex.load();
+	commandArena.writeIndex.store(readIndex ^ 1);
+	auto& buffer = commandArena.buffers[readIndex];
+	while (buffer.writers.load() != 0)
+		YieldProcessor();
+
 	if (drawingEnabled) {
-		for (const auto& cmd : commandQueue.queue) {
-			switch (cmd->type) {
+		const auto end = std::min(buffer.head.load(), CommandBuffer::Capacity);
+		for (size_t offset = 0; offset < end;) {
+			const auto header = reinterpret_cast<const CommandHeader*>(buffer.data + offset);
+			if (header->stride == 0) break;
+
+			const auto payload = buffer.data + offset + sizeof(CommandHeader);
+			switch (header->type) {
 				case CommandType::DrawLine:
 				{
-					drawers.line->Submit(obj, *reinterpret_cast<DrawLine*>(cmd.get()));
+					lineBatcher->Add(*reinterpret_cast<const DrawLine*>(payload));
 					break;
 				}
 				case CommandType::DrawBox:
 				{
-					drawers.box->Submit(obj, *reinterpret_cast<DrawBox*>(cmd.get()));
+					lineBatcher->Add(*reinterpret_cast<const DrawBox*>(payload));
 					break;
 				}
 				default:
 					break;
 			}
+			offset += header->stride;
 		}
+
+		lineBatcher->Draw(obj);
 	}
-	commandQueue.queue.clear();
+
+#ifdef _DEBUG
+	if (buffer.dropped.load() != 0)
+		LOG_WARNING("Debug drawing dropped %u commands, the command buffer is full", buffer.dropped.load());
+#endif
+	buffer.head.store(0);
+	buffer.dropped.store(0);
 
 	const auto state = GetAsyncKeyState(VK_INSERT);
 	if (state && !drawTogglePressed) {
@@ -221,11 +274,8 @@ void DebugDrawing::Flush() {
 }
 
 void DebugDrawing::CreateDrawers() {
-	drawers.line = std::make_unique<DebugDrawing::LineDrawer>(obj);
-	drawers.line->CreateShaders(obj);
-
-	drawers.box = std::make_unique<DebugDrawing::BoxDrawer>(obj);
-	drawers.box->CreateShaders(obj);
+	lineBatcher = std::make_unique<DebugDrawing::LineBatcher>(obj);
+	lineBatcher->CreateShaders(obj);
 }
 
 void DebugDrawing::CreateBuffer(size_t size, D3D11_BIND_FLAG binding, ID3D11Buffer*& buffer) {
@@ -240,12 +290,14 @@ void DebugDrawing::CreateBuffer(size_t size, D3D11_BIND_FLAG binding, ID3D11Buff
 	assert(buffer != nullptr);
 }
 
-#pragma region LineDrawer
-DebugDrawing::LineDrawer::LineDrawer(const D3DObjects& obj) {
-	CreateBuffer(sizeof(float) * 16, D3D11_BIND_FLAG::D3D11_BIND_VERTEX_BUFFER, vertexBuffer);
+#pragma region LineBatcher
+DebugDrawing::LineBatcher::LineBatcher(const D3DObjects& obj) {
+	// Enough for a few hundred lines before we need to grow
+	vertices.reserve(1024);
+	Reserve(1024);
 }
 
-bool DebugDrawing::LineDrawer::CreateLayout(const D3DObjects& obj, ID3DBlob* shader) {
+bool DebugDrawing::LineBatcher::CreateLayout(const D3DObjects& obj, ID3DBlob* shader) {
 	D3D11_INPUT_ELEMENT_DESC desc[] = {
 		{ "POS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 		{ "COL", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
@@ -257,7 +309,7 @@ bool DebugDrawing::LineDrawer::CreateLayout(const D3DObjects& obj, ID3DBlob* sha
 	return SUCCEEDED(layoutCode);
 }
 
-bool DebugDrawing::LineDrawer::CreateShaders(const D3DObjects& obj) {
+bool DebugDrawing::LineBatcher::CreateShaders(const D3DObjects& obj) {
 	vertexShader = std::make_unique<Shader>(drawLineVS, ShaderType::VERTEX);
 	pixelShader = std::make_unique<Shader>(drawLinePS, ShaderType::FRAGMENT);
 
@@ -272,136 +324,55 @@ bool DebugDrawing::LineDrawer::CreateShaders(const D3DObjects& obj) {
 	return true;
 }
 
-void DebugDrawing::LineDrawer::Submit(const D3DObjects& obj, const DebugDrawing::DrawLine& cmd) {
-	UINT stride = sizeof(float) * 8;
-	UINT offset = 0;
-	obj.context->IASetInputLayout(inputLayout);
-	obj.context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-	const auto code = obj.context->Map(vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedBuffer);
-	assert(SUCCEEDED(code));
-
-	auto data = reinterpret_cast<float*>(mappedBuffer.pData);
-	data[0] = cmd.start.point.x;
-	data[1] = cmd.start.point.y;
-	data[2] = 0.0f;
-	data[3] = 1.0f;
-	data[4] = cmd.start.color.x;
-	data[5] = cmd.start.color.y;
-	data[6] = cmd.start.color.z;
-	data[7] = 1.0f;
-
-	data[8] = cmd.end.point.x;
-	data[9] = cmd.end.point.y;
-	data[10] = 0.0f;
-	data[11] = 1.0f;
-	data[12] = cmd.end.color.x;
-	data[13] = cmd.end.color.y;
-	data[14] = cmd.end.color.z;
-	data[15] = 1.0f;
-
-	obj.context->Unmap(vertexBuffer, 0);
-	obj.context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-	vertexShader->Use(obj);
-	pixelShader->Use(obj);
-	obj.context->Draw(2, 0);
+void DebugDrawing::LineBatcher::Add(const DebugDrawing::DrawLine& cmd) {
+	const auto first = vertices.size();
+	vertices.resize(first + lineVertexCount);
+	PackLine(cmd.start.point, cmd.start.color, cmd.end.point, cmd.end.color, vertices.data() + first);
 }
-#pragma endregion
 
-#pragma region BoxDrawer
-DebugDrawing::BoxDrawer::BoxDrawer(const D3DObjects& obj) {
-	constexpr auto lineSize = sizeof(float) * 16;
-	CreateBuffer(lineSize * 12, D3D11_BIND_FLAG::D3D11_BIND_VERTEX_BUFFER, vertexBuffer);
+void DebugDrawing::LineBatcher::Add(const DebugDrawing::DrawBox& cmd) {
+	const auto first = vertices.size();
+	vertices.resize(first + boxVertexCount);
+	PackBox(cmd.box, cmd.color, vertices.data() + first);
 }
 
-bool DebugDrawing::BoxDrawer::CreateLayout(const D3DObjects& obj, ID3DBlob* shader) {
-	D3D11_INPUT_ELEMENT_DESC desc[] = {
-		{ "POS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "COL", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	};
+// Grows the vertex buffer so it can hold at least vertexCount vertices
+void DebugDrawing::LineBatcher::Reserve(size_t vertexCount) {
+	if (vertexCount <= vertexCapacity) return;
 
-	const auto layoutCode = obj.device->CreateInputLayout(desc, ARRAYSIZE(desc),
-		shader->GetBufferPointer(), shader->GetBufferSize(), &inputLayout);
+	auto capacity = glm::max(vertexCapacity, static_cast<size_t>(1024));
+	while (capacity < vertexCount)
+		capacity *= 2;
 
-	return SUCCEEDED(layoutCode);
+	if (vertexBuffer) {
+		vertexBuffer->Release();
+		vertexBuffer = nullptr;
+	}
+	CreateBuffer(capacity * sizeof(PackedVertex), D3D11_BIND_FLAG::D3D11_BIND_VERTEX_BUFFER, vertexBuffer);
+	vertexCapacity = capacity;
 }
 
-bool DebugDrawing::BoxDrawer::CreateShaders(const D3DObjects& obj) {
-	vertexShader = std::make_unique<Shader>(drawLineVS, ShaderType::VERTEX);
-	pixelShader = std::make_unique<Shader>(drawLinePS, ShaderType::FRAGMENT);
-
-	auto vertexBlob = vertexShader->Compile();
-	auto fragmentBlob = pixelShader->Compile();
-	assert(vertexBlob != nullptr);
-	assert(fragmentBlob != nullptr);
+// Uploads and draws everything added since the last call
+void DebugDrawing::LineBatcher::Draw(const D3DObjects& obj) {
+	if (vertices.empty()) return;
+	Reserve(vertices.size());
 
-	assert(CreateLayout(obj, vertexBlob));
-	assert(vertexShader->Create(obj, vertexBlob));
-	assert(pixelShader->Create(obj, fragmentBlob));
-	return true;
-}
+	D3D11_MAPPED_SUBRESOURCE mappedBuffer;
+	const auto code = obj.context->Map(vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedBuffer);
+	assert(SUCCEEDED(code));
+	memcpy(mappedBuffer.pData, vertices.data(), vertices.size() * sizeof(PackedVertex));
+	obj.context->Unmap(vertexBuffer, 0);
 
-void DebugDrawing::BoxDrawer::Submit(const D3DObjects& obj, const DebugDrawing::DrawBox& cmd) {
-	UINT stride = sizeof(float) * 8;
+	UINT stride = sizeof(PackedVertex);
 	UINT offset = 0;
 	obj.context->IASetInputLayout(inputLayout);
 	obj.context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-	const auto code = obj.context->Map(vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedBuffer);
-	assert(SUCCEEDED(code));
-
-	const auto insertLineSegment = [](float* buffer, size_t startIndex, const glm::vec2& a, const glm::vec2& b,
-		const glm::vec3& color)
-	{
-		buffer[startIndex + 0] = a.x;
-		buffer[startIndex + 1] = a.y;
-		buffer[startIndex + 2] = 0.0f;
-		buffer[startIndex + 3] = 1.0f;
-		buffer[startIndex + 4] = color.x;
-		buffer[startIndex + 5] = color.y;
-		buffer[startIndex + 6] = color.z;
-		buffer[startIndex + 7] = 1.0f;
-
-		buffer[startIndex + 8] = b.x;
-		buffer[startIndex + 9] = b.y;
-		buffer[startIndex + 10] = 0.0f;
-		buffer[startIndex + 11] = 1.0f;
-		buffer[startIndex + 12] = color.x;
-		buffer[startIndex + 13] = color.y;
-		buffer[startIndex + 14] = color.z;
-		buffer[startIndex + 15] = 1.0f;
-		return startIndex + 16;
-	};
-
-	const auto blf = cmd.box[0];
-	const auto brf = cmd.box[1];
-	const auto blb = cmd.box[2];
-	const auto brb = cmd.box[3];
-	const auto tlf = cmd.box[4];
-	const auto trf = cmd.box[5];
-	const auto tlb = cmd.box[6];
-	const auto trb = cmd.box[7];
-
-	auto data = reinterpret_cast<float*>(mappedBuffer.pData);
-	size_t currentIndex = 0;
-	currentIndex = insertLineSegment(data, currentIndex, blf, blb, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, blf, brf, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, brf, brb, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, brb, blb, cmd.color);
-
-	currentIndex = insertLineSegment(data, currentIndex, tlf, tlb, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, tlf, trf, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, trf, trb, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, trb, tlb, cmd.color);
-
-	currentIndex = insertLineSegment(data, currentIndex, blf, tlf, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, brf, trf, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, blb, tlb, cmd.color);
-	currentIndex = insertLineSegment(data, currentIndex, brb, trb, cmd.color);
-
-	obj.context->Unmap(vertexBuffer, 0);
 	obj.context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
 	vertexShader->Use(obj);
 	pixelShader->Use(obj);
-	obj.context->Draw(24, 0);
+	obj.context->Draw(static_cast<UINT>(vertices.size()), 0);
+
+	vertices.clear();
 }
 #pragma endregion
 
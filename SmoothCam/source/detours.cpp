@@ -1,6 +1,7 @@
 #include "detours.h"
 #include "camera.h"
 #include "arrow_fixes.h"
+#include "interned_names.h"
 
 #include <common/ITimer.h>
 
@@ -100,7 +101,7 @@ uintptr_t __fastcall mOnInput(PlayerInputHandler* pThis, InputEvent* input) {
 				const BSFixedString* const id = ev->GetControlID();
 				if (!id || !id->data) break;
 
-				if (strcmp(id->data, "Toggle POV") == 0) {
+				if (InternedNames::Is(id->data, InternedNames::Name::TogglePOV)) {
 					std::shared_ptr<Camera::SmoothCamera> lockedPtr;
 					if (!g_theCamera.expired() && (lockedPtr = g_theCamera.lock(), lockedPtr != nullptr)) {
 						lockedPtr->OnTogglePOV(ev);
@@ -124,7 +125,12 @@ uintptr_t __fastcall mOnInput(PlayerInputHandler* pThis, InputEvent* input) {
 typedef EventResult(__thiscall* MenuOpenCloseHandler)(uintptr_t pThis, MenuOpenCloseEvent* ev, EventDispatcher<MenuOpenCloseEvent>* dispatcher);
 EventResult __fastcall mMenuOpenCloseHandler(uintptr_t pThis, MenuOpenCloseEvent* ev, EventDispatcher<MenuOpenCloseEvent>* dispatcher) {
 	if (pThis == (uintptr_t)&(*g_thePlayer)->menuOpenCloseEvent) {
-		if (ev->menuName != nullptr && strcmp(ev->menuName, "Dialogue Menu") == 0) {
+		// Cells and their physics worlds come and go behind loading screens
+		if (InternedNames::Is(ev->menuName, InternedNames::Name::LoadingMenu)) {
+			Physics::InvalidateWorldCache();
+		}
+
+		if (InternedNames::Is(ev->menuName, InternedNames::Name::DialogueMenu)) {
 			std::shared_ptr<Camera::SmoothCamera> lockedPtr;
 			if (!g_theCamera.expired() && (lockedPtr = g_theCamera.lock(), lockedPtr != nullptr)) {
 				lockedPtr->OnDialogMenuChanged(ev);
@@ -137,6 +143,7 @@ EventResult __fastcall mMenuOpenCloseHandler(uintptr_t pThis, MenuOpenCloseEvent
 bool Detours::Attach(std::shared_ptr<Camera::SmoothCamera> theCamera) {
 	g_theCamera = theCamera;
 	timer.Start();
+	InternedNames::Initialize();
 
 	{
 		PLH::VFuncSwapHook playerInputHooks(
@@ -148,7 +155,7 @@ bool Detours::Attach(std::shared_ptr<Camera::SmoothCamera> theCamera) {
 		);
 
 		if (!playerInputHooks.hook()) {
-			_ERROR("Failed to place detour on target virtual function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target virtual function, this error is fatal.");
 			FatalError(L"Failed to place detour on target virtual function, this error is fatal.");
 		}
 	}
@@ -164,7 +171,7 @@ bool Detours::Attach(std::shared_ptr<Camera::SmoothCamera> theCamera) {
 		);
 
 		if (!menuOpenCloseHooks.hook()) {
-			_ERROR("Failed to place detour on target virtual function, this error is fatal.");
+			LOG_ERROR("Failed to place detour on target virtual function, this error is fatal.");
 			FatalError(L"Failed to place detour on target virtual function, this error is fatal.");
 		}
 	}
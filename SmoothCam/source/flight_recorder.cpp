@@ -0,0 +1,173 @@
+#include "flight_recorder.h"
+#include "spsc_ring.h"
+
+#include <thread>
+#include <condition_variable>
+#include <share.h>
+
+namespace {
+	// Start a new file past this size, keeping the last one around
+	constexpr long maxFileSize = 16 * 1024 * 1024;
+	// How often the writer wakes to drain the queue
+	constexpr auto writeInterval = std::chrono::milliseconds(100);
+
+	// A bit over 15 seconds at 60 fps, enough to ride out a slow disk
+	SPSCRing<FlightRecorder::FrameRecord, 1024> queue;
+
+	struct {
+		std::thread writer;
+		std::mutex lock;
+		std::condition_variable wake;
+		bool stopRequested = false;
+		std::atomic<bool> running = false;
+
+		FILE* file = nullptr;
+		std::wstring path;
+		std::wstring prevPath;
+		long fileSize = 0;
+
+		uint64_t nextFrame = 0;
+		uint32_t droppedAtStart = 0;
+		double microsPerTick = 0.0;
+		uint32_t timerFrequency = 0;
+	} recorder;
+
+	struct ThreadGuard {
+		// The game may exit with the writer still running, don't let std::thread terminate us on unload
+		~ThreadGuard() {
+			if (recorder.writer.joinable())
+				recorder.writer.detach();
+		}
+	} threadGuard;
+
+	bool OpenTraceFile() {
+		// Let the trace be read while the game is still writing it
+		recorder.file = _wfsopen(recorder.path.c_str(), L"wb", _SH_DENYWR);
+		if (!recorder.file) return false;
+
+		const FlightRecorder::FileHeader header = {
+			FlightRecorder::fileMagic,
+			FlightRecorder::fileVersion,
+			static_cast<uint32_t>(sizeof(FlightRecorder::FrameRecord)),
+			recorder.timerFrequency
+		};
+		fwrite(&header, sizeof(header), 1, recorder.file);
+		recorder.fileSize = sizeof(header);
+		return true;
+	}
+
+	void WriteRecords(const FlightRecorder::FrameRecord* records, size_t count) {
+		if (!recorder.file || count == 0) return;
+
+		if (recorder.fileSize >= maxFileSize) {
+			fclose(recorder.file);
+			recorder.file = nullptr;
+			_wremove(recorder.prevPath.c_str());
+			_wrename(recorder.path.c_str(), recorder.prevPath.c_str());
+			if (!OpenTraceFile()) return;
+		}
+
+		fwrite(records, sizeof(FlightRecorder::FrameRecord), count, recorder.file);
+		recorder.fileSize += static_cast<long>(sizeof(FlightRecorder::FrameRecord) * count);
+	}
+
+	void WriterThread() {
+		std::array<FlightRecorder::FrameRecord, 64> batch;
+		bool stopping = false;
+		while (!stopping) {
+			{
+				std::unique_lock<std::mutex> lock(recorder.lock);
+				recorder.wake.wait_for(lock, writeInterval, [] { return recorder.stopRequested; });
+				stopping = recorder.stopRequested;
+			}
+
+			size_t count = 0;
+			while (queue.Pop(batch[count])) {
+				if (++count == batch.size()) {
+					WriteRecords(batch.data(), count);
+					count = 0;
+				}
+			}
+			WriteRecords(batch.data(), count);
+		}
+
+		if (recorder.file) {
+			fclose(recorder.file);
+			recorder.file = nullptr;
+		}
+	}
+}
+
+// Opens the trace file and starts the writer thread
+bool FlightRecorder::Start() {
+	if (recorder.running) return true;
+
+	wchar_t path[MAX_PATH];
+	if (!SUCCEEDED(SHGetFolderPath(NULL, CSIDL_PERSONAL, NULL, SHGFP_TYPE_CURRENT, path))) {
+		LOG_WARNING("Failed to locate My Documents folder, flight recorder not started.");
+		return false;
+	}
+	const auto folder = std::wstring(path) + L"\\My Games\\Skyrim Special Edition\\SKSE\\";
+	recorder.path = folder + L"SmoothCam_Trace.bin";
+	recorder.prevPath = folder + L"SmoothCam_Trace.prev.bin";
+
+	LARGE_INTEGER f;
+	QueryPerformanceFrequency(&f);
+	recorder.microsPerTick = 1000000.0 / static_cast<double>(f.QuadPart);
+	recorder.timerFrequency = static_cast<uint32_t>(f.QuadPart);
+
+	if (!OpenTraceFile()) {
+		LOG_WARNING("Failed to open the flight recorder trace file, flight recorder not started.");
+		return false;
+	}
+
+	recorder.nextFrame = 0;
+	recorder.droppedAtStart = queue.Dropped();
+	recorder.stopRequested = false;
+	recorder.writer = std::thread(WriterThread);
+	recorder.running = true;
+	LOG_MESSAGE("Flight recorder started.");
+	return true;
+}
+
+// Writes out anything still queued and stops the writer thread
+void FlightRecorder::Stop() {
+	if (!recorder.running) return;
+
+	{
+		std::lock_guard<std::mutex> lock(recorder.lock);
+		recorder.stopRequested = true;
+	}
+	recorder.wake.notify_one();
+	recorder.writer.join();
+	recorder.running = false;
+
+	const auto dropped = queue.Dropped() - recorder.droppedAtStart;
+	if (dropped > 0)
+		LOG_WARNING("Flight recorder dropped %u frames, the writer could not keep up.", dropped);
+	LOG_MESSAGE("Flight recorder stopped after %llu frames.", recorder.nextFrame);
+}
+
+// Returns true while the writer thread is running
+bool FlightRecorder::IsRunning() noexcept {
+	return recorder.running;
+}
+
+// Game thread only - numbers and queues a record, it is dropped if the writer has fallen behind
+void FlightRecorder::Submit(FrameRecord& record) noexcept {
+	record.frame = recorder.nextFrame++;
+	record.dropped = queue.Dropped() - recorder.droppedAtStart;
+	queue.Push(record);
+}
+
+// Returns a timestamp for zone timings
+int64_t FlightRecorder::Ticks() noexcept {
+	LARGE_INTEGER i;
+	QueryPerformanceCounter(&i);
+	return i.QuadPart;
+}
+
+// Converts a span of ticks to microseconds
+float FlightRecorder::TicksToMicros(int64_t ticks) noexcept {
+	return static_cast<float>(static_cast<double>(ticks) * recorder.microsPerTick);
+}
\ No newline at end of file
@@ -295,6 +295,52 @@ const bool GameState::IsUsingBow(PlayerCharacter* player) noexcept {
 	return false;
 }
 
+namespace {
+	// Matches the first ammo form in an inventory walk
+	class AmmoMatcher : public FormMatcher {
+		public:
+			bool Matches(TESForm* form) const override {
+				return form && form->formType == kFormType_Ammo;
+			}
+	};
+
+	// Returns the projectile of the first effect on the spell that launches one
+	const BGSProjectile* GetSpellProjectile(TESForm* form) noexcept {
+		if (!form) return nullptr;
+		const auto spell = DYNAMIC_CAST(form, TESForm, SpellItem);
+		if (!spell) return nullptr;
+
+		for (UInt32 i = 0; i < spell->effectItemList.count; i++) {
+			MagicItem::EffectItem* effect = nullptr;
+			if (!spell->effectItemList.GetNthItem(i, effect) || !effect || !effect->mgef) continue;
+			if (effect->mgef->properties.projectile) return effect->mgef->properties.projectile;
+		}
+		return nullptr;
+	}
+}
+
+// Returns the projectile the player would launch with the drawn bow, crossbow or spell, or nullptr
+const BGSProjectile* GameState::GetEquippedProjectile(PlayerCharacter* player) noexcept {
+	if (!GameState::IsWeaponDrawn(player)) return nullptr;
+
+	if (GameState::IsUsingBow(player) || GameState::IsUsingCrossbow(player)) {
+		auto changes = static_cast<ExtraContainerChanges*>(
+			player->extraData.GetByType(kExtraData_ContainerChanges)
+		);
+		if (!changes) return nullptr;
+
+		AmmoMatcher matcher;
+		const auto equipped = changes->FindEquipped(matcher);
+		if (!equipped.pForm) return nullptr;
+
+		const auto ammo = DYNAMIC_CAST(equipped.pForm, TESForm, TESAmmo);
+		return ammo ? ammo->settings.projectile : nullptr;
+	}
+
+	if (const auto projectile = GetSpellProjectile(player->rightHandSpell)) return projectile;
+	return GetSpellProjectile(player->leftHandSpell);
+}
+
 // Returns true if the player is sneaking
 const bool GameState::IsSneaking(const PlayerCharacter* player) noexcept {
 	const auto movementBits = GameState::GetPlayerMovementBits(player);
@@ -0,0 +1,47 @@
+#include "interned_names.h"
+
+namespace {
+	constexpr auto nameCount = static_cast<size_t>(InternedNames::Name::MAX_NAME);
+
+	// Indexed by InternedNames::Name
+	constexpr const char* nameText[nameCount] = {
+		"Toggle POV",
+		"Dialogue Menu",
+		"Loading Menu",
+	};
+
+	// Hold a reference to each string so it stays in the string table
+	// These are leaked on purpose - static destructors run after the game has torn down its string cache
+	std::array<BSFixedString*, nameCount> nameRefs = {};
+	std::array<const char*, nameCount> resolved = {};
+}
+
+void InternedNames::Initialize() {
+	for (size_t i = 0; i < nameCount; i++) {
+		if (!nameRefs[i]) nameRefs[i] = new BSFixedString(nameText[i]);
+		resolved[i] = nameRefs[i]->data;
+	}
+}
+
+const char* InternedNames::Get(Name name) noexcept {
+	return resolved[static_cast<size_t>(name)];
+}
+
+bool InternedNames::Is(const char* str, Name name) noexcept {
+	if (!str) return false;
+	const auto match = str == resolved[static_cast<size_t>(name)];
+
+#ifdef _DEBUG
+	// The string table ignores case, so check the same way
+	static bool reportedMismatch = false;
+	if (!reportedMismatch && match != (_stricmp(str, nameText[static_cast<size_t>(name)]) == 0)) {
+		LOG_WARNING("Interned name lookup for '%s' disagrees with a string compare against '%s'",
+			str, nameText[static_cast<size_t>(name)]);
+		reportedMismatch = true;
+		AsyncLog::Flush();
+		__debugbreak();
+	}
+#endif
+
+	return match;
+}
\ No newline at end of file
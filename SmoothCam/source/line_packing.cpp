@@ -0,0 +1,43 @@
+#include "line_packing.h"
+#include "mmath_simd.h"
+#include <cstdint>
+#include <utility>
+
+namespace {
+	// Pairs of corners making up each edge of a box
+	constexpr std::array<std::pair<uint8_t, uint8_t>, 12> boxEdges = { {
+		// Bottom
+		{ 0, 2 }, { 0, 1 }, { 1, 3 }, { 3, 2 },
+		// Top
+		{ 4, 6 }, { 4, 5 }, { 5, 7 }, { 7, 6 },
+		// Sides
+		{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+	} };
+	static_assert(boxEdges.size() * 2 == DebugDrawing::boxVertexCount);
+	static_assert(sizeof(glm::vec2) == sizeof(float) * 2 && sizeof(glm::vec3) == sizeof(float) * 3,
+		"The packing kernel expects tightly packed vectors");
+}
+
+// Writes the 2 vertices of a screen space line to out, returning the number written
+size_t DebugDrawing::PackLine(const glm::vec2& start, const glm::vec3& startColor, const glm::vec2& end,
+	const glm::vec3& endColor, PackedVertex* out) noexcept
+{
+	const glm::vec2 points[lineVertexCount] = { start, end };
+	const glm::vec3 colors[lineVertexCount] = { startColor, endColor };
+	mmath::SIMD::GetKernels().packVertices(&points[0].x, &colors[0].x, 3, lineVertexCount, &out->position.x);
+	return lineVertexCount;
+}
+
+// Writes the 12 edges of a projected box to out as 24 vertices, returning the number written
+size_t DebugDrawing::PackBox(const BoxCorners& corners, const glm::vec3& color, PackedVertex* out) noexcept {
+	std::array<glm::vec2, boxVertexCount> points;
+	size_t i = 0;
+	for (const auto& [a, b] : boxEdges) {
+		points[i++] = corners[a];
+		points[i++] = corners[b];
+	}
+
+	// Every vertex shares the one color
+	mmath::SIMD::GetKernels().packVertices(&points[0].x, &color.x, 0, i, &out->position.x);
+	return i;
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "main.h"
 #include "detours.h"
 #include "papyrus.h"
+#include "mmath_simd.h"
 
 #ifdef _DEBUG
 #   include "debug_drawing.h"
@@ -73,16 +74,18 @@ extern "C" {
 	}
 
 	__declspec(dllexport) bool SKSEPlugin_Load(const SKSEInterface* skse) {
+		AsyncLog::Start();
+
 		g_messaging = reinterpret_cast<SKSEMessagingInterface*>(skse->QueryInterface(kInterface_Messaging));
 		if (!g_messaging) {
-			_ERROR("Failed to load messaging interface! This error is fatal, will not load.");
+			LOG_ERROR("Failed to load messaging interface! This error is fatal, will not load.");
 			FatalError(L"Failed to load messaging interface! This error is fatal, will not load.");
 			return false;
 		}
 
 		g_papyrus = reinterpret_cast<SKSEPapyrusInterface*>(skse->QueryInterface(kInterface_Papyrus));
 		if (!g_papyrus) {
-			_ERROR("Failed to load scripting interface! This error is fatal, will not load.");
+			LOG_ERROR("Failed to load scripting interface! This error is fatal, will not load.");
 			FatalError(L"Failed to load scripting interface! This error is fatal, will not load.");
 			return false;
 		}
@@ -91,14 +94,16 @@ extern "C" {
 		
 		g_papyrus->Register([](VMClassRegistry* registry) {
 			PapyrusBindings::Bind(registry);
-			_MESSAGE("Papyrus native function registration completed.");
+			LOG_MESSAGE("Papyrus native function registration completed.");
 			return true;
 		});
 
+		mmath::SIMD::Initialize();
+
 		Config::ReadConfigFile();
 		g_theCamera = std::make_shared<Camera::SmoothCamera>();
 
-		_MESSAGE("SmoothCam loaded!");
+		LOG_MESSAGE("SmoothCam loaded!");
 		return true;
 	}
 }
\ No newline at end of file
@@ -1,9 +1,5 @@
 ﻿#include <immintrin.h>
-
-namespace {
-	typedef NiPoint3(__thiscall TESObjectREFR::* GetBoundMin)();
-	typedef NiPoint3(__thiscall TESObjectREFR::* GetBoundMax)();
-}
+#include "mmath_simd.h"
 
 bool mmath::IsInf(const float& f) noexcept {
 	return glm::isinf(f);
@@ -35,19 +31,30 @@ bool mmath::IsValid(const glm::vec4& v) noexcept {
 	return !mmath::IsInf(v) && !mmath::IsNan(v);
 }
 
+// Computes the sine and cosine of 4 angles at once
+void mmath::SinCos(const glm::vec4& angles, glm::vec4& sines, glm::vec4& cosines) noexcept {
+	SIMD::GetKernels().sinCos(&angles.x, &sines.x, &cosines.x);
+}
+
 // Return the forward view vector
 glm::vec3 mmath::GetViewVector(const glm::vec3& forwardRefer, float pitch, float yaw) noexcept {
-	auto aproxNormal = glm::vec4(forwardRefer.x, forwardRefer.y, forwardRefer.z, 1.0);
-
-	auto m = glm::identity<glm::mat4>();
-	m = glm::rotate(m, -pitch, glm::vec3(1.0f, 0.0f, 0.0f));
-	aproxNormal = m * aproxNormal;
-	
-	m = glm::identity<glm::mat4>();
-	m = glm::rotate(m, -yaw, glm::vec3(0.0f, 0.0f, 1.0f));
-	aproxNormal = m * aproxNormal;
+	float sines[2];
+	float cosines[2];
+	glm::vec4 columns[3];
+	SIMD::GetKernels().cameraBasis(pitch, yaw, sines, cosines, &columns[0].x);
+	return static_cast<glm::vec3>(
+		(columns[0] * forwardRefer.x) + (columns[1] * forwardRefer.y) + (columns[2] * forwardRefer.z)
+	);
+}
 
-	return static_cast<glm::vec3>(aproxNormal);
+// Returns the camera rotation matrix for the given pitch and yaw
+glm::mat4 mmath::GetViewMatrix(const float pitch, const float yaw) noexcept {
+	float sines[2];
+	float cosines[2];
+	glm::mat4 m;
+	SIMD::GetKernels().cameraBasis(pitch, yaw, sines, cosines, &m[0].x);
+	m[3] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	return m;
 }
 
 glm::vec3 mmath::NiMatrixToEuler(const NiMatrix33& m) noexcept {
@@ -68,6 +75,294 @@ glm::vec3 mmath::NiMatrixToEuler(const NiMatrix33& m) noexcept {
 }
 
 NiMatrix33 mmath::ToddHowardTransform(const float pitch, const float yaw) noexcept {
+	CameraBasis basis;
+	glm::vec4 columns[3];
+	SIMD::GetKernels().cameraBasis(pitch, yaw, &basis.sin.x, &basis.cos.x, &columns[0].x);
+	return ToddHowardTransform(basis);
+}
+
+NiMatrix33 mmath::ToddHowardTransform(const CameraBasis& basis) noexcept {
+	// Create a matrix to flip coords from D3D NDC space to scaleform
+	// ¯\_(ツ)_/¯
+	// This is Rx(-pi/2) * Ry(-pitch) * Rz(yaw - pi/2) with X and Y flipped, written out
+	const auto sp = basis.sin.x;
+	const auto sy = basis.sin.y;
+	const auto cp = basis.cos.x;
+	const auto cy = basis.cos.y;
+
+	NiMatrix33 mat;
+	mat.data[0][0] = -cp * sy;
+	mat.data[0][1] = -sp * sy;
+	mat.data[0][2] = cy;
+	mat.data[1][0] = -cp * cy;
+	mat.data[1][1] = -sp * cy;
+	mat.data[1][2] = -sy;
+	mat.data[2][0] = sp;
+	mat.data[2][1] = -cp;
+	mat.data[2][2] = 0.0f;
+
+	return mat;
+}
+
+// Builds the world to clip matrix the same way NiCamera does, from the camera frustum, rotation and position
+void mmath::ComputeWorldToScreen(const NiFrustum& frustum, const NiMatrix33& rotation, const glm::vec3& position,
+	NiMatrix44& worldToScreen) noexcept
+{
+	// NiCameras look down their local X axis, with Y up and Z right
+	const glm::vec3 dir = { rotation.data[0][0], rotation.data[1][0], rotation.data[2][0] };
+	const glm::vec3 up = { rotation.data[0][1], rotation.data[1][1], rotation.data[2][1] };
+	const glm::vec3 right = { rotation.data[0][2], rotation.data[1][2], rotation.data[2][2] };
+
+	const auto invRmL = 1.0f / (frustum.m_fRight - frustum.m_fLeft);
+	const auto invTmB = 1.0f / (frustum.m_fTop - frustum.m_fBottom);
+	const auto invFmN = 1.0f / (frustum.m_fFar - frustum.m_fNear);
+	const auto rpl = frustum.m_fRight + frustum.m_fLeft;
+	const auto tpb = frustum.m_fTop + frustum.m_fBottom;
+
+	// Rows of the projection applied to the camera space axes, the translation column is computed after
+	glm::vec3 row0, row1, row2, row3;
+	float w0, w1, w2, w3;
+	if (frustum.m_bOrtho) {
+		row0 = right * (2.0f * invRmL);
+		row1 = up * (2.0f * invTmB);
+		row2 = dir * invFmN;
+		row3 = { 0.0f, 0.0f, 0.0f };
+		w0 = -rpl * invRmL;
+		w1 = -tpb * invTmB;
+		w2 = -frustum.m_fNear * invFmN;
+		w3 = 1.0f;
+	} else {
+		row0 = ((right * 2.0f) - (dir * rpl)) * invRmL;
+		row1 = ((up * 2.0f) - (dir * tpb)) * invTmB;
+		row2 = dir * (frustum.m_fFar * invFmN);
+		row3 = dir;
+		w0 = 0.0f;
+		w1 = 0.0f;
+		w2 = -frustum.m_fNear * frustum.m_fFar * invFmN;
+		w3 = 0.0f;
+	}
+
+	const auto writeRow = [&worldToScreen, &position](int i, const glm::vec3& row, float w) noexcept {
+		worldToScreen.data[i][0] = row.x;
+		worldToScreen.data[i][1] = row.y;
+		worldToScreen.data[i][2] = row.z;
+		worldToScreen.data[i][3] = w - glm::dot(row, position);
+	};
+	writeRow(0, row0, w0);
+	writeRow(1, row1, w1);
+	writeRow(2, row2, w2);
+	writeRow(3, row3, w3);
+}
+
+// Builds the shared camera basis for the given pitch and yaw
+mmath::CameraBasis mmath::ComputeCameraBasis(const float pitch, const float yaw) noexcept {
+	CameraBasis basis;
+	glm::vec4 columns[3];
+	SIMD::GetKernels().cameraBasis(pitch, yaw, &basis.sin.x, &basis.cos.x, &columns[0].x);
+
+	basis.pitch = pitch;
+	basis.yaw = yaw;
+	basis.right = static_cast<glm::vec3>(columns[0]);
+	basis.forward = static_cast<glm::vec3>(columns[1]);
+	basis.up = static_cast<glm::vec3>(columns[2]);
+
+	basis.view[0] = columns[0];
+	basis.view[1] = columns[1];
+	basis.view[2] = columns[2];
+	basis.view[3] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	basis.quat = glm::quat_cast(basis.view);
+	return basis;
+}
+
+// Rotates a { side, zoom, up } camera offset by the view, the height stays world aligned
+glm::vec3 mmath::TransformLocalOffset(const glm::vec3& local, const CameraBasis& basis) noexcept {
+	auto translated = (basis.right * local.x) + (basis.forward * local.y);
+	translated.z += local.z;
+	return translated;
+}
+
+// Projects a point onto the basis vectors of the camera, returns { right, forward, up } coefficients
+glm::vec3 mmath::DecomposeToBasis(const glm::vec3& point, const CameraBasis& basis) noexcept {
+	const glm::vec4 columns[3] = {
+		{ basis.right, 0.0f },
+		{ basis.forward, 0.0f },
+		{ basis.up, 0.0f },
+	};
+	glm::vec3 coef;
+	SIMD::GetKernels().project(&point.x, &columns[0].x, &coef.x);
+	return coef;
+}
+
+// Decompose a position to 3 basis vectors and the coefficients, given an euler rotation
+void mmath::DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
+	glm::vec3& forward, glm::vec3& right, glm::vec3& up, glm::vec3& coef) noexcept
+{
+	const auto& kernels = SIMD::GetKernels();
+	glm::vec4 columns[3];
+	kernels.eulerBasis(&rotation.x, &columns[0].x);
+	kernels.project(&point.x, &columns[0].x, &coef.x);
+
+	forward = static_cast<glm::vec3>(columns[0]);
+	right = static_cast<glm::vec3>(columns[1]);
+	up = static_cast<glm::vec3>(columns[2]);
+}
+
+// Projects points to the screen with a cached world to clip matrix, 4 at a time
+void mmath::ProjectPoints(const NiMatrix44& worldToScreen, const NiRect<float>& port, const glm::vec3* points, size_t count,
+	glm::vec3* screen, uint8_t* visible, float zeroTolerance) noexcept
+{
+	static_assert(sizeof(glm::vec3) == sizeof(float) * 3, "Projection kernels expect tightly packed vec3 arrays");
+	const float viewport[4] = { port.m_left, port.m_right, port.m_top, port.m_bottom };
+	SIMD::GetKernels().screenProject(
+		&worldToScreen.data[0][0], viewport,
+		&points->x, count, zeroTolerance,
+		&screen->x, visible
+	);
+}
+
+// Interpolate<float, float> over count channels at once
+void mmath::InterpolateChannels(const float* from, const float* to, const float* scalars, size_t count,
+	float* out) noexcept
+{
+	SIMD::GetKernels().interpolate(from, to, scalars, count, out);
+}
+
+// Clips a line segment to the part in front of the camera, returns false if it is entirely behind
+bool mmath::ClipSegment(const NiMatrix44& worldToScreen, glm::vec3& start, glm::vec3& end, float zeroTolerance) noexcept {
+	const auto& m = worldToScreen.data;
+	const auto wStart = m[3][0] * start.x + m[3][1] * start.y + m[3][2] * start.z + m[3][3];
+	const auto wEnd = m[3][0] * end.x + m[3][1] * end.y + m[3][2] * end.z + m[3][3];
+
+	// Pull the clipped point a little past the tolerance so it still projects
+	const auto plane = glm::max(zeroTolerance, 0.0f) * 2.0f;
+	if (wStart <= plane && wEnd <= plane) return false;
+	if (wStart > plane && wEnd > plane) return true;
+
+	const auto t = (plane - wStart) / (wEnd - wStart);
+	const auto clipped = start + (end - start) * t;
+	if (wStart <= plane)
+		start = clipped;
+	else
+		end = clipped;
+	return true;
+}
+
+glm::vec2 mmath::PointToScreen(const glm::vec3& point) {
+	auto port = NiRect<float>();
+	port.m_left = -1.0f;
+	port.m_right = 1.0f;
+	port.m_top = 1.0f;
+	port.m_bottom = -1.0f;
+
+	glm::vec3 screen;
+	uint8_t visible;
+	ProjectPoints(*reinterpret_cast<const NiMatrix44*>(g_worldToCamMatrix.GetPtr()), port, &point, 1, &screen, &visible);
+
+	if (!visible || screen.z < -1.0f)
+		return { -100.0f, -100.0f };
+
+	return { screen.x, screen.y };
+}
+
+// Moves position towards target along a critically damped spring, carrying velocity between calls
+void mmath::CriticalSpring(glm::vec4& position, glm::vec4& velocity, const glm::vec4& target,
+	float omegaXY, float omegaZ, float deltaTime) noexcept
+{
+	// x(t) = target + (c0 + c1 * t) * e^(-omega * t), with c0 = x(0) - target and c1 = v(0) + omega * c0
+	const auto decayXY = glm::exp(-omegaXY * deltaTime);
+	const auto decayZ = glm::exp(-omegaZ * deltaTime);
+	const auto omega = glm::vec4(omegaXY, omegaXY, omegaZ, 0.0f);
+	const auto decay = glm::vec4(decayXY, decayXY, decayZ, 0.0f);
+
+	const auto c0 = position - target;
+	const auto c1 = velocity + omega * c0;
+	position = target + (c0 + c1 * deltaTime) * decay;
+	velocity = (velocity - omega * c1 * deltaTime) * decay;
+}
+
+namespace {
+	// Antiderivative of sqrt(u^2 + h^2), with h the horizontal speed
+	inline float ArcIntegral(float u, float h) noexcept {
+		const auto root = glm::sqrt(u * u + h * h);
+		return 0.5f * (u * root + (h > 1e-4f ? h * h * glm::asinh(u / h) : 0.0f));
+	}
+}
+
+// Time for a projectile to cover range units along its arc, the way the game measures projectile range
+// Speed changes along the arc, so this is only range / speed when there is no gravity
+float mmath::BallisticFlightTime(const glm::vec3& direction, float speed, float gravity, float range) noexcept {
+	if (speed <= 0.0f || range <= 0.0f) return 0.0f;
+	if (gravity <= 0.0f) return range / speed;
+
+	const auto velocity = direction * speed;
+	const auto h = glm::length(glm::vec2(velocity.x, velocity.y));
+	const auto start = ArcIntegral(velocity.z, h);
+
+	// Arc length grows monotonically with time at the current speed, Newton converges in a few steps
+	auto t = range / speed;
+	for (auto i = 0; i < 6; i++) {
+		const auto vz = velocity.z - gravity * t;
+		const auto length = (start - ArcIntegral(vz, h)) / gravity;
+		const auto curSpeed = glm::sqrt(vz * vz + h * h);
+		if (curSpeed <= 0.0f) break;
+		t = glm::max(t - (length - range) / curSpeed, 0.0f);
+	}
+	return t;
+}
+
+// Samples the arc of a projectile into chords, using more of them the longer the flight so that no chord
+// strays more than maxSag units from the arc. The points lie exactly on the arc.
+size_t mmath::BallisticPath(const glm::vec3& origin, const glm::vec3& direction, float speed, float gravity,
+	float range, float maxSag, size_t maxSegments, glm::vec3* out) noexcept
+{
+	out[0] = origin;
+	if (maxSegments == 0 || speed <= 0.0f || range <= 0.0f) return 1;
+
+	// A chord spanning dt seconds of a parabola sags gravity * dt^2 / 8 below it at the middle
+	const auto flightTime = BallisticFlightTime(direction, speed, gravity, range);
+	auto segments = maxSegments;
+	if (gravity > 0.0f && maxSag > 0.0f) {
+		const auto chordTime = glm::sqrt(8.0f * maxSag / gravity);
+		segments = glm::clamp(static_cast<size_t>(glm::ceil(flightTime / chordTime)), static_cast<size_t>(1), maxSegments);
+	}
+
+	const auto velocity = direction * speed;
+	const auto dt = flightTime / static_cast<float>(segments);
+	for (size_t i = 1; i <= segments; i++) {
+		const auto t = dt * static_cast<float>(i);
+		out[i] = origin + velocity * t - glm::vec3(0.0f, 0.0f, 0.5f * gravity * t * t);
+	}
+	return segments + 1;
+}
+
+#pragma region Scalar reference implementations
+void mmath::Scalar::SinCos(const glm::vec4& angles, glm::vec4& sines, glm::vec4& cosines) noexcept {
+	sines = glm::sin(angles);
+	cosines = glm::cos(angles);
+}
+
+glm::vec3 mmath::Scalar::GetViewVector(const glm::vec3& forwardRefer, float pitch, float yaw) noexcept {
+	auto aproxNormal = glm::vec4(forwardRefer.x, forwardRefer.y, forwardRefer.z, 1.0);
+
+	auto m = glm::identity<glm::mat4>();
+	m = glm::rotate(m, -pitch, glm::vec3(1.0f, 0.0f, 0.0f));
+	aproxNormal = m * aproxNormal;
+	
+	m = glm::identity<glm::mat4>();
+	m = glm::rotate(m, -yaw, glm::vec3(0.0f, 0.0f, 1.0f));
+	aproxNormal = m * aproxNormal;
+
+	return static_cast<glm::vec3>(aproxNormal);
+}
+
+glm::mat4 mmath::Scalar::GetViewMatrix(const float pitch, const float yaw) noexcept {
+	auto m = glm::identity<glm::mat4>();
+	m = glm::rotate(m, -yaw, glm::vec3(0.0f, 0.0f, 1.0f)); // yaw
+	m = glm::rotate(m, -pitch, glm::vec3(1.0f, 0.0f, 0.0f)); // pitch
+	return m;
+}
+
+NiMatrix33 mmath::Scalar::ToddHowardTransform(const float pitch, const float yaw) noexcept {
 	// Create a matrix to flip coords from D3D NDC space to scaleform
 	// ¯\_(ツ)_/¯
 	auto m = glm::identity<glm::mat4>();
@@ -89,8 +384,7 @@ NiMatrix33 mmath::ToddHowardTransform(const float pitch, const float yaw) noexce
 	return mat;
 }
 
-// Decompose a position to 3 basis vectors and the coefficients, given an euler rotation
-void mmath::DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
+void mmath::Scalar::DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
 	glm::vec3& forward, glm::vec3& right, glm::vec3& up, glm::vec3& coef) noexcept
 {
 	// @Note: This assumes an XYZ rotation order
@@ -123,23 +417,47 @@ void mmath::DecomposeToBasis(const glm::vec3& point, const glm::vec3& rotation,
 	};
 }
 
-glm::vec2 mmath::PointToScreen(const glm::vec3& point) {
-	auto port = NiRect<float>();
-	port.m_left = -1.0f;
-	port.m_right = 1.0f;
-	port.m_top = 1.0f;
-	port.m_bottom = -1.0f;
+// Mirrors NiCamera::WorldPtToScreenPt3
+bool mmath::Scalar::ProjectPoint(const NiMatrix44& worldToScreen, const NiRect<float>& port, const glm::vec3& point,
+	glm::vec3& screen, float zeroTolerance) noexcept
+{
+	const auto& m = worldToScreen.data;
+	const auto w = m[3][0] * point.x + m[3][1] * point.y + m[3][2] * point.z + m[3][3];
+	if (w <= glm::max(zeroTolerance, 0.0f)) return false;
 
-	glm::vec3 screen = {};
-	auto niPt = NiPoint3(point.x, point.y, point.z);
-	(*WorldPtToScreenPt3_Internal)(
-		g_worldToCamMatrix,
-		&port, &niPt,
-		&screen.x, &screen.y, &screen.z, 9.99999975e-06
-	);
+	const auto invW = 1.0f / w;
+	screen.x = (m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3]) * invW;
+	screen.y = (m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3]) * invW;
+	screen.z = (m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3]) * invW;
+	screen.x = (screen.x * (port.m_right - port.m_left) + (port.m_left + port.m_right)) * 0.5f;
+	screen.y = (screen.y * (port.m_top - port.m_bottom) + (port.m_top + port.m_bottom)) * 0.5f;
+	return true;
+}
 
-	if (screen.z < -1.0f)
-		return { -100.0f, -100.0f };
+void mmath::Scalar::InterpolateChannels(const float* from, const float* to, const float* scalars, size_t count,
+	float* out) noexcept
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = Interpolate<float, float>(from[i], to[i], scalars[i]);
+}
 
-	return { screen.x, screen.y };
-}
\ No newline at end of file
+// Steps a projectile through time until it falls through the plane at planeZ, returning where it crossed
+glm::vec3 mmath::Scalar::BallisticImpact(const glm::vec3& origin, const glm::vec3& velocity, float gravity, float planeZ,
+	float timeStep) noexcept
+{
+	auto position = origin;
+	auto v = velocity;
+	// Give up after a minute of flight
+	const auto maxSteps = static_cast<size_t>(60.0f / timeStep);
+	for (size_t i = 0; i < maxSteps; i++) {
+		const auto last = position;
+		v.z -= gravity * timeStep;
+		position += v * timeStep;
+		if (position.z <= planeZ && v.z < 0.0f) {
+			const auto t = (last.z - planeZ) / (last.z - position.z);
+			return last + (position - last) * t;
+		}
+	}
+	return position;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,105 @@
+﻿#include "mmath_simd.h"
+#ifdef _MSC_VER
+#   include <intrin.h>
+#else
+#   include <cpuid.h>
+#endif
+
+namespace {
+	// The stand-alone test builds use gcc or clang, which spell these differently
+	void CpuId(int info[4], int leaf, int subLeaf = 0) noexcept {
+#ifdef _MSC_VER
+		__cpuidex(info, leaf, subLeaf);
+#else
+		unsigned int regs[4];
+		__cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+		for (auto i = 0; i < 4; i++)
+			info[i] = static_cast<int>(regs[i]);
+#endif
+	}
+
+	uint64_t XGetBV(uint32_t index) noexcept {
+#ifdef _MSC_VER
+		return _xgetbv(index);
+#else
+		uint32_t eax, edx;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+		return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+	}
+
+	const mmath::SIMD::KernelTable* activeKernels = nullptr;
+	mmath::SIMD::ISA activeISA = mmath::SIMD::ISA::SSE2;
+
+	const mmath::SIMD::KernelTable* GetTable(mmath::SIMD::ISA isa) noexcept {
+		switch (isa) {
+			case mmath::SIMD::ISA::AVX2:
+				return mmath::SIMD::AVX2::GetKernelTable();
+			case mmath::SIMD::ISA::AVX:
+				return mmath::SIMD::AVX::GetKernelTable();
+			case mmath::SIMD::ISA::SSE2:
+			default:
+				return mmath::SIMD::SSE2::GetKernelTable();
+		}
+	}
+}
+
+// Returns the best instruction set supported by the CPU and OS
+mmath::SIMD::ISA mmath::SIMD::DetectISA() noexcept {
+	int info[4];
+	CpuId(info, 0);
+	const auto maxLeaf = info[0];
+
+	CpuId(info, 1);
+	const auto hasOSXSave = (info[2] & (1 << 27)) != 0;
+	const auto hasAVX = (info[2] & (1 << 28)) != 0;
+	const auto hasFMA = (info[2] & (1 << 12)) != 0;
+	if (!hasOSXSave || !hasAVX) return ISA::SSE2;
+
+	// The OS also has to save the YMM registers for us
+	if ((XGetBV(0) & 0x6) != 0x6) return ISA::SSE2;
+
+	if (maxLeaf >= 7) {
+		CpuId(info, 7);
+		const auto hasAVX2 = (info[1] & (1 << 5)) != 0;
+		if (hasAVX2 && hasFMA) return ISA::AVX2;
+	}
+
+	return ISA::AVX;
+}
+
+// Selects the best kernels for this CPU, call once during plugin load
+void mmath::SIMD::Initialize() noexcept {
+	ForceISA(DetectISA());
+	LOG_MESSAGE("Using %s math kernels", GetISAName(activeISA));
+}
+
+// Forces a specific kernel table, returns false if the CPU does not support it
+bool mmath::SIMD::ForceISA(ISA isa) noexcept {
+	if (isa >= ISA::MAX_ISA || isa > DetectISA()) return false;
+	activeISA = isa;
+	activeKernels = GetTable(isa);
+	return true;
+}
+
+// Returns the instruction set of the active kernel table
+mmath::SIMD::ISA mmath::SIMD::GetActiveISA() noexcept {
+	return activeISA;
+}
+
+// Returns a printable name for the instruction set
+const char* mmath::SIMD::GetISAName(ISA isa) noexcept {
+	switch (isa) {
+		case ISA::SSE2: return "SSE2";
+		case ISA::AVX: return "AVX";
+		case ISA::AVX2: return "AVX2";
+		default: return "Unknown";
+	}
+}
+
+// Returns the active kernel table
+const mmath::SIMD::KernelTable& mmath::SIMD::GetKernels() noexcept {
+	// The baseline table is always safe to use if we get called before Initialize
+	if (!activeKernels) activeKernels = SSE2::GetKernelTable();
+	return *activeKernels;
+}
\ No newline at end of file
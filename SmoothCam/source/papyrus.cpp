@@ -62,11 +62,16 @@ const std::unordered_map<std::string_view, std::function<bool(void)>> boolGetter
 	IMPL_GETTER("FirstPersonSitting",				compatIC_FirstPersonSitting)
 	IMPL_GETTER("IFPVCompat",						compatIFPV)
 	IMPL_GETTER("InterpolationEnabled",				enableInterp)
+	IMPL_GETTER("SpringInterpolationEnabled",		springInterp)
 	IMPL_GETTER("SeparateLocalInterpolation",		separateLocalInterp)
 	IMPL_GETTER("DisableDeltaTime",					disableDeltaTime)
+	IMPL_GETTER("EnableFixedStepSimulation",		fixedStepSimulation)
+	IMPL_GETTER("EnableFlightRecorder",				enableFlightRecorder)
+	IMPL_GETTER("EnableDebugLogging",				enableDebugLogging)
 	IMPL_GETTER("DisableDuringDialog",				disableDuringDialog)
 	IMPL_GETTER("Enable3DBowCrosshair",				use3DBowAimCrosshair)
 	IMPL_GETTER("Enable3DMagicCrosshair",			use3DMagicCrosshair)
+	IMPL_GETTER("EnableBallisticCrosshair",			crosshairBallisticAim)
 	IMPL_GETTER("EnableCrosshairSizeManip",			enableCrosshairSizeManip)
 	IMPL_GETTER("HideCrosshairOutOfCombat",			hideNonCombatCrosshair)
 	IMPL_GETTER("HideCrosshairMeleeCombat",			hideCrosshairMeleeCombat)
@@ -113,12 +118,17 @@ const std::unordered_map<std::string_view, std::function<float(void)>> floatGett
 	IMPL_GETTER("MinFollowDistance",					minCameraFollowDistance)
 	IMPL_GETTER("MinCameraFollowRate",					minCameraFollowRate)
 	IMPL_GETTER("MaxCameraFollowRate",					maxCameraFollowRate)
+	IMPL_GETTER("SpringSmoothTimeXY",					springSmoothTimeXY)
+	IMPL_GETTER("SpringSmoothTimeZ",					springSmoothTimeZ)
 	IMPL_GETTER("MaxSmoothingInterpDistance",			zoomMaxSmoothingDistance)
 	IMPL_GETTER("ZoomMul",								zoomMul)
+	IMPL_GETTER("FixedStepRate",						fixedStepRate)
 
 	IMPL_GETTER("CrosshairNPCGrowSize",					crosshairNPCHitGrowSize)
 	IMPL_GETTER("CrosshairMinDistSize",					crosshairMinDistSize)
 	IMPL_GETTER("CrosshairMaxDistSize",					crosshairMaxDistSize)
+	IMPL_GETTER("CrosshairRayMaxInterval",				crosshairRayMaxInterval)
+	IMPL_GETTER("CrosshairRayMaxLength",				crosshairRayMaxLength)
 
 	IMPL_GETTER("SepZMaxInterpDistance",				separateZMaxSmoothingDistance)
 	IMPL_GETTER("SepZMinFollowRate",					separateZMinFollowRate)
@@ -250,11 +260,16 @@ const std::unordered_map<std::string_view, std::function<void(bool)>> boolSetter
 	IMPL_SETTER("FirstPersonSitting",				compatIC_FirstPersonSitting, bool)
 	IMPL_SETTER("IFPVCompat",						compatIFPV, bool)	
 	IMPL_SETTER("InterpolationEnabled",				enableInterp, bool)
+	IMPL_SETTER("SpringInterpolationEnabled",		springInterp, bool)
 	IMPL_SETTER("SeparateLocalInterpolation",		separateLocalInterp, bool)
 	IMPL_SETTER("DisableDeltaTime",					disableDeltaTime, bool)
+	IMPL_SETTER("EnableFixedStepSimulation",		fixedStepSimulation, bool)
+	IMPL_SETTER("EnableFlightRecorder",				enableFlightRecorder, bool)
+	IMPL_SETTER("EnableDebugLogging",				enableDebugLogging, bool)
 	IMPL_SETTER("DisableDuringDialog",				disableDuringDialog, bool)
 	IMPL_SETTER("Enable3DBowCrosshair",				use3DBowAimCrosshair, bool)
 	IMPL_SETTER("Enable3DMagicCrosshair",			use3DMagicCrosshair, bool)
+	IMPL_SETTER("EnableBallisticCrosshair",			crosshairBallisticAim, bool)
 	IMPL_SETTER("EnableCrosshairSizeManip",			enableCrosshairSizeManip, bool)
 	IMPL_SETTER("HideCrosshairOutOfCombat",			hideNonCombatCrosshair, bool)
 	IMPL_SETTER("HideCrosshairMeleeCombat",			hideCrosshairMeleeCombat, bool)
@@ -301,12 +316,17 @@ const std::unordered_map<std::string_view, std::function<void(float)>> floatSett
 	IMPL_SETTER("MinFollowDistance",					minCameraFollowDistance, float)
 	IMPL_SETTER("MinCameraFollowRate",					minCameraFollowRate, float)
 	IMPL_SETTER("MaxCameraFollowRate",					maxCameraFollowRate, float)
+	IMPL_SETTER("SpringSmoothTimeXY",					springSmoothTimeXY, float)
+	IMPL_SETTER("SpringSmoothTimeZ",					springSmoothTimeZ, float)
 	IMPL_SETTER("MaxSmoothingInterpDistance",			zoomMaxSmoothingDistance, float)
 	IMPL_SETTER("ZoomMul",								zoomMul, float)
+	IMPL_SETTER("FixedStepRate",						fixedStepRate, float)
 
 	IMPL_SETTER("CrosshairNPCGrowSize",					crosshairNPCHitGrowSize, float)
 	IMPL_SETTER("CrosshairMinDistSize",					crosshairMinDistSize, float)
 	IMPL_SETTER("CrosshairMaxDistSize",					crosshairMaxDistSize, float)
+	IMPL_SETTER("CrosshairRayMaxInterval",				crosshairRayMaxInterval, float)
+	IMPL_SETTER("CrosshairRayMaxLength",				crosshairRayMaxLength, float)
 
 	IMPL_SETTER("SepZMaxInterpDistance",				separateZMaxSmoothingDistance, float)
 	IMPL_SETTER("SepZMinFollowRate",					separateZMinFollowRate, float)
@@ -1,6 +1,24 @@
 namespace {
 	typedef bhkWorld*(__fastcall* bhkWorldGetter)(const TESObjectCELL* cell);
 	constexpr auto hkpBroadphaseOffset = 0x88;
+	// TESObjectCELL::cellState, a cell only has a physics world while it is attached
+	constexpr auto cellStateOffset = 0x44;
+	constexpr uint8_t cellStateAttached = 7;
+
+	// The world of the last cell we looked up
+	struct {
+		const TESObjectCELL* cell = nullptr;
+		bhkWorld* world = nullptr;
+		// Identity of the havok world behind world, checked against the engine in debug builds
+		intptr_t hkpWorld = 0;
+	} worldCache;
+	// Set from the menu event handler, which may run off the main thread
+	std::atomic_bool worldCacheDirty = true;
+
+	// Returns true if the cell is attached to the scene, and so has its physics world set up
+	bool IsAttached(const TESObjectCELL* cell) noexcept {
+		return *reinterpret_cast<const uint8_t*>(reinterpret_cast<uintptr_t>(cell) + cellStateOffset) == cellStateAttached;
+	}
 }
 
 hkp3AxisSweep* Physics::GetBroadphase(const bhkWorld* physicsWorld) {
@@ -10,4 +28,38 @@ hkp3AxisSweep* Physics::GetBroadphase(const bhkWorld* physicsWorld) {
 
 bhkWorld* Physics::GetWorld(const TESObjectCELL* parentCell) {
 	return Offsets::Get<bhkWorldGetter>(18536)(parentCell); // 0x2654c0
+}
+
+// Returns the physics world of the player's cell, only asking the engine again when the cell changes or is reattached
+bhkWorld* Physics::GetCurrentWorld(const PlayerCharacter* player) {
+	if (!player || !player->parentCell) return nullptr;
+
+	// Cells can be detached and attached again without a loading screen, taking their world with them
+	// While the cell is anywhere between those states, ask the engine each time and drop what we had
+	if (!IsAttached(player->parentCell)) {
+		worldCache.cell = nullptr;
+		return GetWorld(player->parentCell);
+	}
+
+	if (worldCacheDirty.exchange(false) || worldCache.cell != player->parentCell || !worldCache.world) {
+		worldCache.cell = player->parentCell;
+		worldCache.world = GetWorld(player->parentCell);
+		worldCache.hkpWorld = worldCache.world ? worldCache.world->unk40() : 0;
+	}
+
+#ifdef _DEBUG
+	// The cache is only as good as its invalidation - make sure the engine agrees
+	if (worldCache.world != GetWorld(player->parentCell) ||
+		(worldCache.world && worldCache.world->unk40() != worldCache.hkpWorld))
+	{
+		__debugbreak();
+	}
+#endif
+
+	return worldCache.world;
+}
+
+// Drops the cached world so the next GetCurrentWorld call looks it up again
+void Physics::InvalidateWorldCache() noexcept {
+	worldCacheDirty.store(true);
 }
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "projection_capture.h"
+
+#ifdef _DEBUG
+#include "camera.h"
+#include <share.h>
+
+namespace {
+	// Enough cases to cover a play session without the files growing for as long as the game runs
+	constexpr size_t maxCases = 64;
+	// Calls between captures, so the cases spread over different views
+	constexpr uint32_t captureInterval = 120;
+
+	typedef struct captureFile {
+		const wchar_t* path;
+		FILE* file;
+		size_t cases;
+		uint32_t calls;
+	} CaptureFile;
+	CaptureFile worldToScreenFile = { L"Data/SKSE/Plugins/SmoothCam_WorldToScreen.inl", nullptr, 0, 0 };
+	CaptureFile pointsFile = { L"Data/SKSE/Plugins/SmoothCam_Projection.inl", nullptr, 0, 0 };
+
+	// Returns true when this call should record a case, opening the file for the first one
+	bool ShouldCapture(CaptureFile& capture) noexcept {
+		if (capture.cases >= maxCases || capture.calls++ % captureInterval != 0) return false;
+		if (!capture.file) {
+			capture.file = _wfsopen(capture.path, L"w", _SH_DENYWR);
+			if (!capture.file) {
+				LOG_WARNING("Failed to open a projection capture file, nothing will be captured to it");
+				capture.cases = maxCases;
+				return false;
+			}
+		}
+		capture.cases++;
+		return true;
+	}
+
+	// Hex floats, so the fixtures hold exactly what the engine wrote
+	void WriteFloats(FILE* file, const float* values, size_t count) noexcept {
+		fputs("{ ", file);
+		for (size_t i = 0; i < count; i++)
+			fprintf(file, i + 1 < count ? "%a, " : "%a", values[i]);
+		fputs(" }", file);
+	}
+}
+
+// Runs 69271 with its own frustum and an orthographic one, writing one row of world_to_screen.inl for each
+void ProjectionCapture::WorldToScreen(NiCamera* camera, const NiMatrix33& rotation) noexcept {
+	if (!ShouldCapture(worldToScreenFile)) return;
+
+	const auto lastRotation = camera->m_worldTransform.rot;
+	const auto lastFrustum = camera->m_frustum;
+	camera->m_worldTransform.rot = rotation;
+
+	const auto& pos = camera->m_worldTransform.pos;
+	const float position[3] = { pos.x, pos.y, pos.z };
+	for (const auto ortho : { false, true }) {
+		if (ortho) {
+			camera->m_frustum.m_bOrtho = true;
+			camera->m_frustum.m_fLeft = -960.0f;
+			camera->m_frustum.m_fRight = 960.0f;
+			camera->m_frustum.m_fTop = 540.0f;
+			camera->m_frustum.m_fBottom = -540.0f;
+		}
+
+		Offsets::Get<Camera::UpdateWorldToScreenMtx>(69271)(camera);
+		const auto engine = *reinterpret_cast<mmath::NiMatrix44*>(camera->m_aafWorldToCam);
+
+		// Say so right away if we have drifted, rather than waiting for the fixtures to be refreshed
+		mmath::NiMatrix44 ours;
+		mmath::ComputeWorldToScreen(camera->m_frustum, rotation, { pos.x, pos.y, pos.z }, ours);
+		for (auto i = 0; i < 16; i++) {
+			const auto e = (&engine.data[0][0])[i];
+			const auto o = (&ours.data[0][0])[i];
+			if (glm::abs(e - o) > 1e-4f * glm::max(1.0f, glm::abs(e))) {
+				LOG_WARNING("%s world to screen matrix differs from the engine at [%d][%d]: %f vs %f",
+					ortho ? "Orthographic" : "Perspective", i / 4, i % 4, o, e);
+				break;
+			}
+		}
+
+		const auto& frustum = camera->m_frustum;
+		const float planes[6] = {
+			frustum.m_fLeft, frustum.m_fRight, frustum.m_fTop, frustum.m_fBottom, frustum.m_fNear, frustum.m_fFar
+		};
+		auto file = worldToScreenFile.file;
+		fprintf(file, "{ %s, ", ortho ? "true" : "false");
+		WriteFloats(file, planes, 6);
+		fputs(", ", file);
+		WriteFloats(file, &rotation.data[0][0], 9);
+		fputs(", ", file);
+		WriteFloats(file, position, 3);
+		fputs(", ", file);
+		WriteFloats(file, &engine.data[0][0], 16);
+		fputs(" },\n", file);
+	}
+	fflush(worldToScreenFile.file);
+
+	camera->m_frustum = lastFrustum;
+	camera->m_worldTransform.rot = lastRotation;
+	Offsets::Get<Camera::UpdateWorldToScreenMtx>(69271)(camera);
+}
+// Projects the points through WorldPtToScreenPt3, writing one row of projection.inl for each
+void ProjectionCapture::Points(NiCamera* camera, const mmath::NiMatrix44& worldToScreen, const NiRect<float>& port,
+	const glm::vec3& hitPos) noexcept
+{
+	if (!ShouldCapture(pointsFile)) return;
+
+	// The last row of a perspective matrix is the view direction, so the points follow the matrix and not the node
+	const auto& m = worldToScreen.data;
+	const auto dir = glm::normalize(glm::vec3(m[3][0], m[3][1], m[3][2]));
+	const auto side = glm::normalize(glm::cross(dir, { 0.0f, 0.0f, 1.0f }));
+	const auto& pos = camera->m_worldTransform.pos;
+	const auto position = glm::vec3(pos.x, pos.y, pos.z);
+	const auto nearPlane = camera->m_frustum.m_fNear;
+
+	// Both sides of the near plane, and behind the camera on and off the view axis
+	const glm::vec3 points[] = {
+		hitPos,
+		position + dir * (nearPlane * 0.5f),
+		position + dir * (nearPlane * 0.999f),
+		position + dir * nearPlane + side * (nearPlane * 0.25f),
+		position + dir * (nearPlane * 1.001f),
+		position - dir * (nearPlane * 0.5f),
+		position - dir * 500.0f + side * 100.0f,
+	};
+
+	auto file = pointsFile.file;
+	const float rect[4] = { port.m_left, port.m_right, port.m_top, port.m_bottom };
+	for (const auto& point : points) {
+		auto pt = NiPoint3(point.x, point.y, point.z);
+		glm::vec3 screen = {};
+		const auto visible = (*WorldPtToScreenPt3_Internal)(
+			const_cast<float*>(&m[0][0]), const_cast<NiRect<float>*>(&port), &pt,
+			&screen.x, &screen.y, &screen.z, mmath::projectionZeroTolerance
+		);
+
+		fputs("{ ", file);
+		WriteFloats(file, &m[0][0], 16);
+		fputs(", ", file);
+		WriteFloats(file, rect, 4);
+		fputs(", ", file);
+		WriteFloats(file, &point.x, 3);
+		fprintf(file, ", %s, ", visible ? "true" : "false");
+		WriteFloats(file, &screen.x, 3);
+		fputs(" },\n", file);
+	}
+	fflush(file);
+}
+#endif
\ No newline at end of file
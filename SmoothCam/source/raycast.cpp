@@ -24,7 +24,7 @@ Raycast::RayResult Raycast::CastRay(glm::vec4 start, glm::vec4 end, float traceH
 
 	ply->handleRefObject.IncRef();
 	{
-		auto physicsWorld = Physics::GetWorld(ply->parentCell);
+		auto physicsWorld = Physics::GetCurrentWorld(ply);
 		if (physicsWorld) {
 			res.hit = Offsets::Get<RayCastFunType>(32270)( // 0x4f45f0
 				playerCamera->physics, physicsWorld,
@@ -48,14 +48,8 @@ hkpCastCollector* getCastCollector() {
 	return &collector;
 }
 
-Raycast::RayResult Raycast::hkpCastRay(glm::vec4 start, glm::vec4 end) {
-#ifdef _DEBUG
-	if (!mmath::IsValid(start) || !mmath::IsValid(end)) {
-		__debugbreak();
-		return {};
-	}
-#endif
-
+// Casts one segment into an already resolved world, the caller holds a reference on the player
+Raycast::RayResult castSegment(bhkWorld* physicsWorld, const glm::vec4& start, const glm::vec4& end) {
 	constexpr auto hkpScale = 0.0142875f;
 	const auto dif = end - start;
 
@@ -65,15 +59,9 @@ Raycast::RayResult Raycast::hkpCastRay(glm::vec4 start, glm::vec4 end) {
 	info.collector = getCastCollector();
 	info.collector->reset();
 
-	auto ply = *g_thePlayer;
-	ply->handleRefObject.IncRef();
-	{
-		auto physicsWorld = Physics::GetWorld(ply->parentCell);
-		if (physicsWorld) {
-			physicsWorld->CastRay(&info);
-		}
+	if (physicsWorld) {
+		physicsWorld->CastRay(&info);
 	}
-	ply->handleRefObject.DecRef();
 
 	hkpRayHitResult best = {};
 	best.hitFraction = 1.0f;
@@ -93,7 +81,7 @@ Raycast::RayResult Raycast::hkpCastRay(glm::vec4 start, glm::vec4 end) {
 		}
 	}
 
-	RayResult result;
+	Raycast::RayResult result;
 	result.hitPos = bestPos;
 	result.rayLength = glm::length(bestPos - start);
 
@@ -116,16 +104,51 @@ Raycast::RayResult Raycast::hkpCastRay(glm::vec4 start, glm::vec4 end) {
 	auto av = Offsets::Get<_GetUserData>(76160)(best.hit);
 	result.hit = av != nullptr;
 
-	// What a useless function, only returning a valid character if it hits the actor origin?
-	/*
-	typedef Character*(__fastcall* ExtractCharacterFromTraceRes)(NiAVObject*);
+	// Walks up from the hit node to the reference that owns it, which may not be a character at all
+	typedef TESObjectREFR*(__fastcall* ExtractCharacterFromTraceRes)(NiAVObject*);
 	if (result.hit) {
-		auto character = Offsets::Get<ExtractCharacterFromTraceRes>(19323)(av);
-		if (character && *reinterpret_cast<char*>(reinterpret_cast<intptr_t>(character) + 0x1a) == '>') {
-			result.hitCharacter = character;
+		auto ref = Offsets::Get<ExtractCharacterFromTraceRes>(19323)(av);
+		if (ref && ref->formType == kFormType_Character) {
+			result.hitCharacter = static_cast<Character*>(ref);
 		}
 	}
-	*/
 
 	return result; 
+}
+
+Raycast::RayResult Raycast::hkpCastRay(glm::vec4 start, glm::vec4 end) {
+#ifdef _DEBUG
+	if (!mmath::IsValid(start) || !mmath::IsValid(end)) {
+		__debugbreak();
+		return {};
+	}
+#endif
+
+	auto ply = *g_thePlayer;
+	ply->handleRefObject.IncRef();
+	const auto result = castSegment(Physics::GetCurrentWorld(ply), start, end);
+	ply->handleRefObject.DecRef();
+	return result;
+}
+
+// The player reference and world lookup are shared by every chord, only the engine cast runs per segment
+Raycast::RayResult Raycast::hkpCastPath(const glm::vec3* points, size_t count) {
+	RayResult result;
+	auto travelled = 0.0f;
+
+	auto ply = *g_thePlayer;
+	ply->handleRefObject.IncRef();
+	auto physicsWorld = Physics::GetCurrentWorld(ply);
+	for (size_t i = 0; i + 1 < count; i++) {
+		result = castSegment(physicsWorld, glm::vec4(points[i], 0.0f), glm::vec4(points[i + 1], 0.0f));
+		if (result.hit) break;
+		travelled += glm::distance(points[i], points[i + 1]);
+	}
+	ply->handleRefObject.DecRef();
+
+	if (result.hit)
+		result.rayLength += travelled;
+	else
+		result.rayLength = travelled;
+	return result;
 }
\ No newline at end of file
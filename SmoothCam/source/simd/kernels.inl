@@ -0,0 +1,316 @@
+﻿// Shared body of the mmath kernels, included once per instruction set
+// The including file defines MMATH_KERNEL_ISA to the namespace to emit, MMATH_KERNEL_AVX and MMATH_KERNEL_FMA to 0 or 1
+// @Note: These are built without the PCH, only use intrinsics and plain floats in here - inline code from other
+// headers would be compiled for the wrong ISA and the linker is free to pick that copy for the rest of the plugin
+#include <immintrin.h>
+#include "mmath_simd.h"
+
+#if !defined(MMATH_KERNEL_ISA) || !defined(MMATH_KERNEL_AVX) || !defined(MMATH_KERNEL_FMA)
+#   error "MMATH_KERNEL_ISA, MMATH_KERNEL_AVX and MMATH_KERNEL_FMA must be defined before including kernels.inl"
+#endif
+
+namespace mmath::SIMD::MMATH_KERNEL_ISA {
+	namespace {
+		// Cephes single precision sin/cos constants
+		constexpr float fourOverPi = 1.27323954473516f;
+		constexpr float negDP1 = -0.78515625f;
+		constexpr float negDP2 = -2.4187564849853515625e-4f;
+		constexpr float negDP3 = -3.77489497744594108e-8f;
+		constexpr float sinCoef0 = -1.9515295891e-4f;
+		constexpr float sinCoef1 = 8.3321608736e-3f;
+		constexpr float sinCoef2 = -1.6666654611e-1f;
+		constexpr float cosCoef0 = 2.443315711809948e-5f;
+		constexpr float cosCoef1 = -1.388731625493765e-3f;
+		constexpr float cosCoef2 = 4.166664568298827e-2f;
+
+		// a * b + c
+		inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) noexcept {
+#if MMATH_KERNEL_FMA
+			return _mm_fmadd_ps(a, b, c);
+#else
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+		}
+
+		// Lanes of a where mask is set, b elsewhere
+		inline __m128 Select(__m128 mask, __m128 a, __m128 b) noexcept {
+#if MMATH_KERNEL_AVX
+			return _mm_blendv_ps(b, a, mask);
+#else
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif
+		}
+
+		// Sine and cosine of 4 angles, accurate to a few ULP for |x| < 8192
+		inline void SinCosPS(__m128 x, __m128& sines, __m128& cosines) noexcept {
+			const auto signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+			const auto one = _mm_set1_ps(1.0f);
+			const auto half = _mm_set1_ps(0.5f);
+
+			// Work with |x|, keep the sign of the input for the sine
+			auto sinSign = _mm_and_ps(x, signMask);
+			x = _mm_andnot_ps(signMask, x);
+
+			// Find the octant and round to an even value
+			auto octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(fourOverPi)));
+			octant = _mm_add_epi32(octant, _mm_set1_epi32(1));
+			octant = _mm_and_si128(octant, _mm_set1_epi32(~1));
+			const auto y = _mm_cvtepi32_ps(octant);
+
+			// Sign flips and polynomial selection depend on the octant
+			const auto sinSwap = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+			const auto cosSign = _mm_castsi128_ps(_mm_slli_epi32(
+				_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29
+			));
+			const auto polyMask = _mm_castsi128_ps(
+				_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128())
+			);
+			sinSign = _mm_xor_ps(sinSign, sinSwap);
+
+			// Extended precision modular arithmetic, x = x - y * pi/4
+			x = MulAdd(y, _mm_set1_ps(negDP1), x);
+			x = MulAdd(y, _mm_set1_ps(negDP2), x);
+			x = MulAdd(y, _mm_set1_ps(negDP3), x);
+			const auto z = _mm_mul_ps(x, x);
+
+			// Cosine polynomial over [0, pi/4]
+			auto pc = MulAdd(_mm_set1_ps(cosCoef0), z, _mm_set1_ps(cosCoef1));
+			pc = MulAdd(pc, z, _mm_set1_ps(cosCoef2));
+			pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+			pc = _mm_sub_ps(pc, _mm_mul_ps(z, half));
+			pc = _mm_add_ps(pc, one);
+
+			// Sine polynomial over [0, pi/4]
+			auto ps = MulAdd(_mm_set1_ps(sinCoef0), z, _mm_set1_ps(sinCoef1));
+			ps = MulAdd(ps, z, _mm_set1_ps(sinCoef2));
+			ps = MulAdd(_mm_mul_ps(ps, z), x, x);
+
+			// Pick the right polynomial for each output
+			const auto s = _mm_or_ps(_mm_and_ps(polyMask, ps), _mm_andnot_ps(polyMask, pc));
+			const auto c = _mm_or_ps(_mm_and_ps(polyMask, pc), _mm_andnot_ps(polyMask, ps));
+			sines = _mm_xor_ps(s, sinSign);
+			cosines = _mm_xor_ps(c, cosSign);
+		}
+
+		void SinCos(const float* angles, float* sines, float* cosines) noexcept {
+			__m128 s, c;
+			SinCosPS(_mm_loadu_ps(angles), s, c);
+			_mm_storeu_ps(sines, s);
+			_mm_storeu_ps(cosines, c);
+		}
+
+		void CameraBasis(float pitch, float yaw, float* sines, float* cosines, float* columns) noexcept {
+			__m128 s, c;
+			SinCosPS(_mm_set_ps(0.0f, 0.0f, yaw, pitch), s, c);
+			alignas(16) float sv[4];
+			alignas(16) float cv[4];
+			_mm_store_ps(sv, s);
+			_mm_store_ps(cv, c);
+			sines[0] = sv[0];
+			sines[1] = sv[1];
+			cosines[0] = cv[0];
+			cosines[1] = cv[1];
+
+			// Rz(-yaw) * Rx(-pitch), written out
+			_mm_storeu_ps(columns, _mm_set_ps(0.0f, 0.0f, -sv[1], cv[1]));
+			_mm_storeu_ps(columns + 4, _mm_mul_ps(
+				_mm_set_ps(0.0f, -1.0f, cv[1], sv[1]),
+				_mm_set_ps(0.0f, sv[0], cv[0], cv[0])
+			));
+			_mm_storeu_ps(columns + 8, _mm_mul_ps(
+				_mm_set_ps(0.0f, 1.0f, cv[1], sv[1]),
+				_mm_set_ps(0.0f, cv[0], sv[0], sv[0])
+			));
+		}
+
+		void EulerBasis(const float* rotation, float* columns) noexcept {
+			// @Note: This assumes an XYZ rotation order
+			__m128 s, c;
+			SinCosPS(_mm_set_ps(0.0f, rotation[2], rotation[1], rotation[0]), s, c);
+			alignas(16) float sv[4];
+			alignas(16) float cv[4];
+			_mm_store_ps(sv, s);
+			_mm_store_ps(cv, c);
+			const auto sx = sv[0];
+			const auto sy = sv[1];
+			const auto sz = sv[2];
+			const auto cx = cv[0];
+			const auto cy = cv[1];
+			const auto cz = cv[2];
+
+			// Forward
+			_mm_storeu_ps(columns, _mm_set_ps(0.0f, sy, -cy * sz, cy * cz));
+			// Right
+			_mm_storeu_ps(columns + 4, _mm_set_ps(0.0f, -cy * sx, cx * cz - sx * sy * sz, cz * sx * sy + cx * sz));
+			// Up
+			_mm_storeu_ps(columns + 8, _mm_set_ps(0.0f, cx * cy, cz * sx + cx * sy * sz, -cx * cz * sy + sx * sz));
+		}
+
+		void Project(const float* point, const float* columns, float* coef) noexcept {
+			// Transpose the basis so all three dot products run at once
+			auto c0 = _mm_loadu_ps(columns);
+			auto c1 = _mm_loadu_ps(columns + 4);
+			auto c2 = _mm_loadu_ps(columns + 8);
+			auto c3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			auto ret = _mm_mul_ps(c0, _mm_set1_ps(point[0]));
+			ret = MulAdd(c1, _mm_set1_ps(point[1]), ret);
+			ret = MulAdd(c2, _mm_set1_ps(point[2]), ret);
+
+			alignas(16) float out[4];
+			_mm_store_ps(out, ret);
+			coef[0] = out[0];
+			coef[1] = out[1];
+			coef[2] = out[2];
+		}
+
+		// Projects 4 points held in SoA form
+		inline void ScreenProject4(const __m128* m, const float* port, __m128 x, __m128 y, __m128 z, __m128 zeroTolerance,
+			__m128& sx, __m128& sy, __m128& sz, __m128& mask) noexcept
+		{
+			const auto row = [&](int i) noexcept {
+				return MulAdd(x, m[i * 4], MulAdd(y, m[i * 4 + 1], MulAdd(z, m[i * 4 + 2], m[i * 4 + 3])));
+			};
+
+			const auto w = row(3);
+			mask = _mm_cmpgt_ps(w, zeroTolerance);
+			// Keep the divide safe for rejected points, they get masked out below
+			const auto invW = _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(_mm_and_ps(mask, w), _mm_andnot_ps(mask, _mm_set1_ps(1.0f))));
+
+			const auto half = _mm_set1_ps(0.5f);
+			const auto lr = _mm_set1_ps(port[0] + port[1]);
+			const auto rml = _mm_set1_ps(port[1] - port[0]);
+			const auto tb = _mm_set1_ps(port[2] + port[3]);
+			const auto tmb = _mm_set1_ps(port[2] - port[3]);
+
+			sx = _mm_mul_ps(row(0), invW);
+			sy = _mm_mul_ps(row(1), invW);
+			sz = _mm_mul_ps(row(2), invW);
+			sx = _mm_mul_ps(MulAdd(sx, rml, lr), half);
+			sy = _mm_mul_ps(MulAdd(sy, tmb, tb), half);
+
+			sx = _mm_and_ps(sx, mask);
+			sy = _mm_and_ps(sy, mask);
+			sz = _mm_and_ps(sz, mask);
+		}
+
+		void ScreenProject(const float* worldToScreen, const float* port, const float* points, size_t count,
+			float zeroTolerance, float* screen, uint8_t* visible) noexcept
+		{
+			__m128 m[16];
+			for (auto i = 0; i < 16; i++)
+				m[i] = _mm_set1_ps(worldToScreen[i]);
+			const auto tolerance = _mm_set1_ps(zeroTolerance > 0.0f ? zeroTolerance : 0.0f);
+
+			alignas(16) float outX[4];
+			alignas(16) float outY[4];
+			alignas(16) float outZ[4];
+			alignas(16) float padded[12];
+
+			for (size_t i = 0; i < count; i += 4) {
+				const auto lanes = count - i < 4 ? count - i : 4;
+				const float* p = points + i * 3;
+				if (lanes < 4) {
+					// Pad the tail out to a full vector
+					for (auto j = 0; j < 12; j++)
+						padded[j] = static_cast<size_t>(j) < lanes * 3 ? p[j] : 0.0f;
+					p = padded;
+				}
+
+				__m128 sx, sy, sz, mask;
+				ScreenProject4(
+					m, port,
+					_mm_set_ps(p[9], p[6], p[3], p[0]),
+					_mm_set_ps(p[10], p[7], p[4], p[1]),
+					_mm_set_ps(p[11], p[8], p[5], p[2]),
+					tolerance,
+					sx, sy, sz, mask
+				);
+
+				_mm_store_ps(outX, sx);
+				_mm_store_ps(outY, sy);
+				_mm_store_ps(outZ, sz);
+				const auto bits = _mm_movemask_ps(mask);
+
+				for (size_t j = 0; j < lanes; j++) {
+					screen[(i + j) * 3] = outX[j];
+					screen[(i + j) * 3 + 1] = outY[j];
+					screen[(i + j) * 3 + 2] = outZ[j];
+					visible[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+				}
+			}
+		}
+
+		void Interpolate(const float* from, const float* to, const float* scalars, size_t count, float* out) noexcept {
+			const auto zero = _mm_setzero_ps();
+			const auto one = _mm_set1_ps(1.0f);
+			alignas(16) float padded[3][4];
+			alignas(16) float result[4];
+
+			for (size_t i = 0; i < count; i += 4) {
+				const auto lanes = count - i < 4 ? count - i : 4;
+				__m128 f, t, s;
+				if (lanes == 4) {
+					f = _mm_loadu_ps(from + i);
+					t = _mm_loadu_ps(to + i);
+					s = _mm_loadu_ps(scalars + i);
+				} else {
+					// Pad the tail out to a full vector
+					for (size_t j = 0; j < 4; j++) {
+						padded[0][j] = j < lanes ? from[i + j] : 0.0f;
+						padded[1][j] = j < lanes ? to[i + j] : 0.0f;
+						padded[2][j] = j < lanes ? scalars[i + j] : 0.0f;
+					}
+					f = _mm_load_ps(padded[0]);
+					t = _mm_load_ps(padded[1]);
+					s = _mm_load_ps(padded[2]);
+				}
+
+				// Kept as a separate multiply and add so every ISA rounds like the scalar code
+				auto ret = _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(t, f), s));
+				ret = Select(_mm_cmpgt_ps(s, one), t, ret);
+				ret = Select(_mm_cmplt_ps(s, zero), f, ret);
+
+				if (lanes == 4) {
+					_mm_storeu_ps(out + i, ret);
+				} else {
+					_mm_store_ps(result, ret);
+					for (size_t j = 0; j < lanes; j++)
+						out[i + j] = result[j];
+				}
+			}
+		}
+
+		void PackVertices(const float* points, const float* colors, size_t colorStride, size_t count,
+			float* out) noexcept
+		{
+			for (size_t i = 0; i < count; i++) {
+				const float* color = colors + i * colorStride;
+				const auto pos = _mm_set_ps(1.0f, 0.0f, points[i * 2 + 1], points[i * 2]);
+				const auto col = _mm_set_ps(1.0f, color[2], color[1], color[0]);
+#if MMATH_KERNEL_AVX
+				// A whole vertex is one 256 bit store
+				_mm256_storeu_ps(out + i * 8, _mm256_insertf128_ps(_mm256_castps128_ps256(pos), col, 1));
+#else
+				_mm_storeu_ps(out + i * 8, pos);
+				_mm_storeu_ps(out + i * 8 + 4, col);
+#endif
+			}
+		}
+
+		const KernelTable table = {
+			&SinCos,
+			&CameraBasis,
+			&EulerBasis,
+			&Project,
+			&ScreenProject,
+			&Interpolate,
+			&PackVertices,
+		};
+	}
+
+	const KernelTable* GetKernelTable() noexcept {
+		return &table;
+	}
+}
\ No newline at end of file
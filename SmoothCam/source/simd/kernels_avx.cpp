@@ -0,0 +1,5 @@
+﻿// VEX encoded build of the mmath kernels, compiled with /arch:AVX (see premake5.lua)
+#define MMATH_KERNEL_ISA AVX
+#define MMATH_KERNEL_AVX 1
+#define MMATH_KERNEL_FMA 0
+#include "kernels.inl"
\ No newline at end of file
@@ -0,0 +1,5 @@
+﻿// AVX2 build of the mmath kernels, compiled with /arch:AVX2 and uses FMA (see premake5.lua)
+#define MMATH_KERNEL_ISA AVX2
+#define MMATH_KERNEL_AVX 1
+#define MMATH_KERNEL_FMA 1
+#include "kernels.inl"
\ No newline at end of file
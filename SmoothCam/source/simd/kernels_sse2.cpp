@@ -0,0 +1,5 @@
+﻿// Baseline build of the mmath kernels, runs on every x64 CPU
+#define MMATH_KERNEL_ISA SSE2
+#define MMATH_KERNEL_AVX 0
+#define MMATH_KERNEL_FMA 0
+#include "kernels.inl"
\ No newline at end of file
@@ -0,0 +1,243 @@
+// Times the math and interpolation kernels so changes to them can be compared
+// Prints the results as json, or writes them to the path given as the first argument
+#include "mmath_simd.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+	// Timed repetitions per benchmark, after one untimed warm-up
+	constexpr size_t repetitions = 15;
+	// Calls per repetition
+	constexpr size_t iterations = 200000;
+	// Inputs are cycled through so calls can't be folded away, must be a power of two
+	constexpr size_t inputCount = 64;
+
+	typedef struct result {
+		std::string name;
+		std::string isa;
+		double meanNs = 0.0;
+		double stddevNs = 0.0;
+		double minNs = 0.0;
+	} Result;
+
+	std::array<float, inputCount> scalars;
+	std::array<glm::vec3, inputCount> points;
+	std::array<glm::vec2, inputCount> angles;
+	std::array<NiMatrix33, inputCount> matrices;
+	std::array<mmath::CameraBasis, inputCount> bases;
+	std::array<glm::vec3, inputCount> screen;
+	std::array<uint8_t, inputCount> visible;
+	std::array<float, inputCount> channels;
+	mmath::NiMatrix44 worldToScreen;
+	NiRect<float> port;
+	volatile float sink = 0.0f;
+
+	void FillInputs() noexcept {
+		for (size_t i = 0; i < inputCount; i++) {
+			const auto t = static_cast<float>(i) / static_cast<float>(inputCount - 1);
+			scalars[i] = t;
+			points[i] = { t * 300.0f - 150.0f, 200.0f - t * 90.0f, t * 40.0f };
+			angles[i] = { (t - 0.5f) * glm::pi<float>(), t * glm::two_pi<float>() };
+			matrices[i] = mmath::Scalar::ToddHowardTransform(angles[i].x, angles[i].y);
+			bases[i] = mmath::ComputeCameraBasis(angles[i].x, angles[i].y);
+		}
+
+		NiFrustum frustum;
+		frustum.m_fLeft = -0.83f;
+		frustum.m_fRight = 0.83f;
+		frustum.m_fTop = 0.47f;
+		frustum.m_fBottom = -0.47f;
+		frustum.m_fNear = 15.0f;
+		frustum.m_fFar = 353840.0f;
+		frustum.m_bOrtho = false;
+		mmath::ComputeWorldToScreen(frustum, matrices[inputCount / 3], { 0.0f, -400.0f, 30.0f }, worldToScreen);
+
+		port.m_left = 0.0f;
+		port.m_right = 1920.0f;
+		port.m_top = 0.0f;
+		port.m_bottom = 1080.0f;
+	}
+
+	// Times fn over each repetition, fn takes an input index and returns something to fold into the sink
+	template<typename Fn>
+	Result Measure(const char* name, const char* isa, Fn&& fn) {
+		const auto runOnce = [&fn]() {
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; i++)
+				sink = sink + static_cast<float>(fn(i & (inputCount - 1)));
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			return elapsed.count() / static_cast<double>(iterations);
+		};
+
+		runOnce();
+		std::array<double, repetitions> samples;
+		for (auto& sample : samples)
+			sample = runOnce();
+
+		Result result;
+		result.name = name;
+		result.isa = isa;
+		result.minNs = samples[0];
+
+		for (const auto sample : samples) {
+			result.meanNs += sample;
+			result.minNs = glm::min(result.minNs, sample);
+		}
+		result.meanNs /= static_cast<double>(repetitions);
+
+		for (const auto sample : samples)
+			result.stddevNs += (sample - result.meanNs) * (sample - result.meanNs);
+		result.stddevNs = glm::sqrt(result.stddevNs / static_cast<double>(repetitions - 1));
+
+		return result;
+	}
+
+	// Functions that dispatch to the kernel table, timed once per instruction set
+	void MeasureKernels(const char* isa, std::vector<Result>& results) {
+		results.push_back(Measure("SinCos", isa, [](size_t i) {
+			glm::vec4 s, c;
+			mmath::SinCos({ angles[i].x, angles[i].y, scalars[i], -scalars[i] }, s, c);
+			return s.x + c.w;
+		}));
+		results.push_back(Measure("GetViewVector", isa, [](size_t i) {
+			return mmath::GetViewVector({ 0.0f, 1.0f, 0.0f }, angles[i].x, angles[i].y).x;
+		}));
+		results.push_back(Measure("GetViewMatrix", isa, [](size_t i) {
+			return mmath::GetViewMatrix(angles[i].x, angles[i].y)[1].x;
+		}));
+		results.push_back(Measure("ToddHowardTransform", isa, [](size_t i) {
+			return mmath::ToddHowardTransform(angles[i].x, angles[i].y).data[0][1];
+		}));
+		results.push_back(Measure("ComputeCameraBasis", isa, [](size_t i) {
+			return mmath::ComputeCameraBasis(angles[i].x, angles[i].y).forward.x;
+		}));
+		results.push_back(Measure("DecomposeToBasis(rotation)", isa, [](size_t i) {
+			glm::vec3 forward, right, up, coef;
+			mmath::DecomposeToBasis(points[i], { angles[i].x, 0.0f, angles[i].y }, forward, right, up, coef);
+			return coef.y;
+		}));
+		results.push_back(Measure("DecomposeToBasis(basis)", isa, [](size_t i) {
+			return mmath::DecomposeToBasis(points[i], bases[i]).y;
+		}));
+		// One call projects every input point, ns/op is per point
+		results.push_back(Measure("ProjectPoints", isa, [](size_t i) {
+			if (i == 0)
+				mmath::ProjectPoints(worldToScreen, port, points.data(), inputCount, screen.data(), visible.data());
+			return screen[i].x;
+		}));
+		// Eases every input scalar at once, ns/op is per channel
+		results.push_back(Measure("InterpolateChannels", isa, [](size_t i) {
+			if (i == 0)
+				mmath::InterpolateChannels(&points[0].x, &points[1].x, scalars.data(), inputCount, channels.data());
+			return channels[i];
+		}));
+	}
+
+	void MeasureScalar(std::vector<Result>& results) {
+		constexpr auto isa = "none";
+
+		results.push_back(Measure("Baseline", isa, [](size_t i) {
+			return scalars[i];
+		}));
+
+		for (const auto& entry : Config::scalarMethodRevLookup) {
+			const auto label = std::string("RunScalarFunction/") + entry.second.c_str();
+			results.push_back(Measure(label.c_str(), isa, [method = entry.first](size_t i) {
+				return mmath::RunScalarFunction<double>(method, static_cast<double>(scalars[i]));
+			}));
+		}
+
+		results.push_back(Measure("Interpolate<dvec3>", isa, [](size_t i) {
+			const glm::dvec3 from = points[i];
+			const glm::dvec3 to = points[(i + 1) & (inputCount - 1)];
+			return mmath::Interpolate<glm::dvec3, double>(from, to, scalars[i]).x;
+		}));
+		results.push_back(Measure("Interpolate<vec3>", isa, [](size_t i) {
+			return mmath::Interpolate<glm::vec3, float>(points[i], points[(i + 1) & (inputCount - 1)], scalars[i]).x;
+		}));
+		results.push_back(Measure("CriticalSpring", isa, [](size_t i) {
+			auto position = glm::vec4(points[i], 0.0f);
+			auto velocity = glm::vec4(scalars[i]);
+			mmath::CriticalSpring(position, velocity, glm::vec4(points[(i + 1) & (inputCount - 1)], 0.0f),
+				6.0f, 10.0f, 1.0f / 60.0f);
+			return position.x;
+		}));
+		results.push_back(Measure("NiMatrixToEuler", isa, [](size_t i) {
+			return mmath::NiMatrixToEuler(matrices[i]).x;
+		}));
+
+		results.push_back(Measure("Scalar::SinCos", isa, [](size_t i) {
+			glm::vec4 s, c;
+			mmath::Scalar::SinCos({ angles[i].x, angles[i].y, scalars[i], -scalars[i] }, s, c);
+			return s.x + c.w;
+		}));
+		results.push_back(Measure("Scalar::GetViewMatrix", isa, [](size_t i) {
+			return mmath::Scalar::GetViewMatrix(angles[i].x, angles[i].y)[1].x;
+		}));
+		results.push_back(Measure("Scalar::ProjectPoint", isa, [](size_t i) {
+			glm::vec3 out;
+			mmath::Scalar::ProjectPoint(worldToScreen, port, points[i], out);
+			return out.x;
+		}));
+		results.push_back(Measure("Scalar::GetViewVector", isa, [](size_t i) {
+			return mmath::Scalar::GetViewVector({ 0.0f, 1.0f, 0.0f }, angles[i].x, angles[i].y).x;
+		}));
+		results.push_back(Measure("Scalar::ToddHowardTransform", isa, [](size_t i) {
+			return mmath::Scalar::ToddHowardTransform(angles[i].x, angles[i].y).data[0][1];
+		}));
+		results.push_back(Measure("Scalar::DecomposeToBasis", isa, [](size_t i) {
+			glm::vec3 forward, right, up, coef;
+			mmath::Scalar::DecomposeToBasis(points[i], { angles[i].x, 0.0f, angles[i].y }, forward, right, up, coef);
+			return coef.y;
+		}));
+	}
+}
+
+int main(int argc, char** argv) {
+	FillInputs();
+
+	std::vector<Result> results;
+	const auto bestISA = mmath::SIMD::DetectISA();
+	for (auto isa = mmath::SIMD::ISA::SSE2; isa <= bestISA; isa = static_cast<mmath::SIMD::ISA>(static_cast<int>(isa) + 1)) {
+		if (mmath::SIMD::ForceISA(isa))
+			MeasureKernels(mmath::SIMD::GetISAName(isa), results);
+	}
+	mmath::SIMD::ForceISA(bestISA);
+
+	MeasureScalar(results);
+
+	Config::json j;
+	j["cpuISA"] = mmath::SIMD::GetISAName(bestISA);
+#ifdef NDEBUG
+	j["build"] = "Release";
+#else
+	j["build"] = "Debug";
+#endif
+	j["repetitions"] = repetitions;
+	j["iterations"] = iterations;
+	j["results"] = Config::json::array();
+	for (const auto& result : results) {
+		_MESSAGE("%s [%s]: %.2f ns/op (stddev %.2f, min %.2f)",
+			result.name.c_str(), result.isa.c_str(), result.meanNs, result.stddevNs, result.minNs);
+		j["results"].push_back({
+			{ "name", result.name },
+			{ "isa", result.isa },
+			{ "nsPerOp", result.meanNs },
+			{ "stddevNs", result.stddevNs },
+			{ "minNs", result.minNs },
+		});
+	}
+
+	if (argc < 2) {
+		std::cout << j.dump(1, '\t') << std::endl;
+		return 0;
+	}
+
+	std::ofstream os(argv[1]);
+	if (!os.is_open()) {
+		_ERROR("Failed to open %s", argv[1]);
+		return 1;
+	}
+	os << j.dump(1, '\t') << std::endl;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+// Stands in for SmoothCam/include/pch.h when the math code is built on its own, without SKSE or Windows
+// Only the game types mmath touches are mirrored here, with the same layout as the SKSE ones
+#include <string>
+#include <stdlib.h>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <fstream>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <tuple>
+#include <limits>
+#include <cstdint>
+#include <cstdio>
+
+#include <mapbox/eternal.hpp>
+
+#define GLM_FORCE_INTRINSICS
+#define GLM_FORCE_LEFT_HANDED
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_QUAT_DATA_WXYZ
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtx/easing.hpp>
+#include <glm/gtx/spline.hpp>
+#include <glm/gtx/norm.hpp>
+
+// Log lines go straight to stderr, stdout is kept for results
+#define _MESSAGE(fmt, ...) std::fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define _WARNING(fmt, ...) std::fprintf(stderr, "Warning: " fmt "\n", ##__VA_ARGS__)
+#define _ERROR(fmt, ...) std::fprintf(stderr, "Error: " fmt "\n", ##__VA_ARGS__)
+// There is no writer thread here, the plugin's async log macros write directly
+#define LOG_MESSAGE(fmt, ...) _MESSAGE(fmt, ##__VA_ARGS__)
+#define LOG_WARNING(fmt, ...) _WARNING(fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) _ERROR(fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) _MESSAGE(fmt, ##__VA_ARGS__)
+
+class NiPoint3 {
+	public:
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+
+		NiPoint3() = default;
+		NiPoint3(float x, float y, float z) : x(x), y(y), z(z) {}
+};
+
+class NiMatrix33 {
+	public:
+		float data[3][3];
+};
+
+template<typename T>
+class NiRect {
+	public:
+		T m_left;
+		T m_right;
+		T m_top;
+		T m_bottom;
+};
+
+class NiFrustum {
+	public:
+		float m_fLeft;
+		float m_fRight;
+		float m_fTop;
+		float m_fBottom;
+		float m_fNear;
+		float m_fFar;
+		bool m_bOrtho;
+};
+
+class BSFixedString {
+	public:
+		const char* data = nullptr;
+};
+
+// The game's world to screen matrix, left as identity
+class WorldToCamMatrix {
+	public:
+		float* GetPtr() noexcept {
+			return &data[0][0];
+		}
+
+	private:
+		float data[4][4] = {
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f, 0.0f },
+			{ 0.0f, 0.0f, 0.0f, 1.0f },
+		};
+};
+inline WorldToCamMatrix g_worldToCamMatrix;
+
+// mmath's templates name the scalar methods, so config comes first here
+#include "config.h"
+#include "mmath.h"
\ No newline at end of file
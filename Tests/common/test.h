@@ -0,0 +1,82 @@
+#pragma once
+#include <cstring>
+#include "mmath_simd.h"
+
+// A minimal test runner, cases register themselves and Tests/unit/main.cpp runs them
+namespace Test {
+	typedef void(*CaseFn)();
+
+	// Adds a case to the run list, called from TEST_CASE at static init
+	bool Register(const char* name, CaseFn fn) noexcept;
+	// Marks the running case as failed
+	void Fail(const char* file, int line, const char* expr) noexcept;
+	// Runs every case whose name contains filter, returns the number that failed
+	size_t RunAll(const char* filter) noexcept;
+
+	// Calls fn with the name of each instruction set the CPU supports, with its kernel table active
+	template<typename Fn>
+	void ForEachISA(Fn&& fn) {
+		const auto selected = mmath::SIMD::GetActiveISA();
+		for (auto i = 0; i < static_cast<int>(mmath::SIMD::ISA::MAX_ISA); i++) {
+			const auto isa = static_cast<mmath::SIMD::ISA>(i);
+			if (mmath::SIMD::ForceISA(isa))
+				fn(mmath::SIMD::GetISAName(isa));
+		}
+		mmath::SIMD::ForceISA(selected);
+	}
+
+	// Distance between two floats in units in the last place
+	uint32_t UlpDistance(float a, float b) noexcept;
+
+	// Worst error seen for one property, a sample fails only if it is over both bounds
+	class Property {
+		public:
+			Property(const char* name, const char* isa, float maxAbs, uint32_t maxUlp) noexcept :
+				name(name), isa(isa), maxAbs(maxAbs), maxUlp(maxUlp) {}
+
+			void Compare(float value, float reference) noexcept {
+				const auto abs = glm::abs(value - reference);
+				const auto ulp = UlpDistance(value, reference);
+				worstAbs = glm::max(worstAbs, abs);
+				worstUlp = glm::max(worstUlp, ulp);
+				if (!(abs <= maxAbs || ulp <= maxUlp)) failures++;
+			}
+
+			template<glm::length_t L, typename T>
+			void Compare(const glm::vec<L, T>& value, const glm::vec<L, T>& reference) noexcept {
+				for (glm::length_t i = 0; i < L; i++)
+					Compare(static_cast<float>(value[i]), static_cast<float>(reference[i]));
+			}
+
+			// Logs the worst error, returns false if any sample was out of bounds
+			bool Report() const noexcept {
+				if (failures > 0) {
+					_ERROR("%s [%s] drifted from the reference in %u values: max abs %g (bound %g), max ulp %u (bound %u)",
+						name, isa, failures, worstAbs, maxAbs, worstUlp, maxUlp);
+					return false;
+				}
+				_MESSAGE("%s [%s]: max abs %g, max ulp %u", name, isa, worstAbs, worstUlp);
+				return true;
+			}
+
+		private:
+			const char* name;
+			const char* isa;
+			float maxAbs;
+			uint32_t maxUlp;
+			float worstAbs = 0.0f;
+			uint32_t worstUlp = 0;
+			uint32_t failures = 0;
+	};
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static const bool name##Registered = Test::Register(#name, name); \
+	static void name()
+
+#define CHECK(expr) \
+	do { if (!(expr)) Test::Fail(__FILE__, __LINE__, #expr); } while (false)
+
+// Checks a property and reports its worst error either way
+#define CHECK_PROPERTY(property) CHECK((property).Report())
\ No newline at end of file
@@ -0,0 +1,5 @@
+// Inputs and output of NiCamera::WorldPtToScreenPt3, one row per point
+// { world to screen matrix, { left, right, top, bottom }, point, visible, screen x, y, depth }
+// Each capture is the crosshair hit, points on both sides of the near plane and points behind the camera, all through
+// the same matrix. Captured from the game by a debug build of the plugin into
+// Data/SKSE/Plugins/SmoothCam_Projection.inl, see ProjectionCapture::Points. Replace the rows below with that file.
\ No newline at end of file
@@ -0,0 +1,4 @@
+// Inputs and output of NiCamera::UpdateWorldToScreenMtx (69271), one row per case
+// { ortho, { left, right, top, bottom, near, far }, rotation, position, m_aafWorldToCam }
+// Captured from the game by a debug build of the plugin into Data/SKSE/Plugins/SmoothCam_WorldToScreen.inl,
+// see ProjectionCapture::WorldToScreen. Replace the rows below with that file to refresh them.
\ No newline at end of file
@@ -0,0 +1,73 @@
+// BallisticPath against a reference integrator over a spread of shots
+#include "test.h"
+
+TEST_CASE(BallisticPathStaysNearTheArc) {
+	constexpr auto maxSag = 4.0f;
+	constexpr size_t maxSegments = 64;
+	std::array<glm::vec3, maxSegments + 1> path;
+
+	for (const auto speed : { 1500.0f, 3000.0f, 5000.0f, 7000.0f }) {
+		for (const auto gravityScale : { 0.1f, 0.35f, 1.0f }) {
+			for (const auto pitch : { -0.5f, -0.1f, 0.0f, 0.2f, 0.6f }) {
+				for (const auto drop : { 16.0f, 256.0f, 2048.0f }) {
+					const auto gravity = gravityScale * mmath::havokGravity;
+					const auto origin = glm::vec3(100.0f, -50.0f, 1000.0f);
+					const auto direction = glm::vec3(0.0f, glm::cos(pitch), glm::sin(pitch));
+					const auto planeZ = origin.z - drop;
+
+					const auto impact = mmath::Scalar::BallisticImpact(origin, direction * speed, gravity, planeZ, 1e-4f);
+					const auto range = glm::distance(origin, impact) * 2.0f;
+					const auto count = mmath::BallisticPath(origin, direction, speed, gravity, range, maxSag, maxSegments,
+						path.data());
+
+					// The reference impact has to sit within the sag limit of one of the chords
+					auto nearest = std::numeric_limits<float>::max();
+					for (size_t i = 0; i + 1 < count; i++) {
+						const auto chord = path[i + 1] - path[i];
+						const auto t = glm::clamp(glm::dot(impact - path[i], chord) / glm::dot(chord, chord), 0.0f, 1.0f);
+						nearest = glm::min(nearest, glm::distance(impact, path[i] + chord * t));
+					}
+
+					if (count == maxSegments + 1) continue; // Capped, the sag limit doesn't hold
+					CHECK(nearest <= maxSag + 1.0f);
+					if (nearest > maxSag + 1.0f) {
+						_ERROR("Ballistic path misses the reference impact by %f units (speed %f, gravity %f, pitch %f, drop %f)",
+							nearest, speed, gravity, pitch, drop);
+						return;
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE(BallisticPathEndsAtRangeAlongTheArc) {
+	constexpr size_t maxSegments = 64;
+	std::array<glm::vec3, maxSegments + 1> path;
+
+	for (const auto speed : { 1500.0f, 5000.0f }) {
+		for (const auto pitch : { -1.5f, -0.5f, 0.0f, 0.6f, 1.5f }) {
+			for (const auto range : { 500.0f, 6000.0f }) {
+				const auto gravity = 0.35f * mmath::havokGravity;
+				const auto direction = glm::vec3(0.0f, glm::cos(pitch), glm::sin(pitch));
+				const auto count = mmath::BallisticPath(glm::vec3(0.0f), direction, speed, gravity, range, 0.0f,
+					maxSegments, path.data());
+				CHECK(count == maxSegments + 1);
+
+				// Integrate the speed over the flight to find how far along the arc the last point is
+				const auto flightTime = mmath::BallisticFlightTime(direction, speed, gravity, range);
+				const auto velocity = direction * speed;
+				constexpr auto steps = 20000;
+				auto length = 0.0;
+				for (auto i = 0; i < steps; i++) {
+					const auto t = (static_cast<float>(i) + 0.5f) * flightTime / steps;
+					length += glm::length(velocity - glm::vec3(0.0f, 0.0f, gravity * t)) * flightTime / steps;
+				}
+
+				const auto drop = velocity.z * flightTime - 0.5f * gravity * flightTime * flightTime;
+				CHECK(glm::abs(length - range) <= range * 1e-3);
+				CHECK(glm::abs(path[count - 1].z - drop) <= 1.0f);
+			}
+		}
+	}
+}
\ No newline at end of file
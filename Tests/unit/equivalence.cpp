@@ -0,0 +1,181 @@
+// The optimized math against frozen copies of the original implementations, over random inputs
+#include "test.h"
+#include <random>
+
+namespace {
+	// Samples drawn per property
+	constexpr size_t sampleCount = 20000;
+	// Fixed so a failure can be reproduced
+	constexpr uint32_t seed = 0x5C0FFEE;
+
+	// Copies of the math as it was before it was optimized, don't change these
+	// They define what "the camera feels the same" means
+	namespace Frozen {
+		glm::mat4 ViewMatrix(float pitch, float yaw) noexcept {
+			auto m = glm::identity<glm::mat4>();
+			m = glm::rotate(m, -yaw, glm::vec3(0.0f, 0.0f, 1.0f));
+			m = glm::rotate(m, -pitch, glm::vec3(1.0f, 0.0f, 0.0f));
+			return m;
+		}
+
+		// BaseCameraState::GetTransformedCameraLocalPosition
+		glm::vec3 TransformLocalOffset(const glm::vec3& local, float pitch, float yaw) noexcept {
+			auto translated = ViewMatrix(pitch, yaw) * glm::vec4(local.x, local.y, 0.0f, 1.0f);
+			translated.z += local.z;
+			return static_cast<glm::vec3>(translated);
+		}
+
+		// BaseCameraState::UpdateInterpolatedWorldPosition
+		glm::vec3 Interpolate(const glm::vec3& from, const glm::vec3& to, double scalar) noexcept {
+			return static_cast<glm::vec3>(mmath::Interpolate<glm::dvec3, double>(from, to, scalar));
+		}
+
+		// A critically damped spring, solved in double precision
+		void CriticalSpring(glm::dvec3& position, glm::dvec3& velocity, const glm::dvec3& target, double omegaXY,
+			double omegaZ, double deltaTime) noexcept
+		{
+			const auto omega = glm::dvec3(omegaXY, omegaXY, omegaZ);
+			const auto decay = glm::exp(-omega * deltaTime);
+			const auto c0 = position - target;
+			const auto c1 = velocity + omega * c0;
+			position = target + (c0 + c1 * deltaTime) * decay;
+			velocity = (velocity - omega * c1 * deltaTime) * decay;
+		}
+	}
+
+	typedef struct inputs {
+		std::mt19937 rng { seed };
+
+		float Uniform(float min, float max) {
+			return std::uniform_real_distribution<float>(min, max)(rng);
+		}
+
+		glm::vec3 Point(float extent) {
+			return { Uniform(-extent, extent), Uniform(-extent, extent), Uniform(-extent, extent) };
+		}
+
+		float Pitch() {
+			return Uniform(-1.5f, 1.5f);
+		}
+
+		float Yaw() {
+			return Uniform(-glm::pi<float>(), glm::pi<float>());
+		}
+	} Inputs;
+}
+
+// Properties of the functions backed by the kernel tables
+TEST_CASE(KernelPathsMatchFrozenMath) {
+	Test::ForEachISA([](const char* isa) {
+		Inputs in;
+		Test::Property sinCos("SinCos", isa, 1e-5f, 64);
+		Test::Property viewVector("GetViewVector", isa, 1e-5f, 64);
+		Test::Property viewMatrix("ComputeCameraBasis", isa, 1e-5f, 64);
+		Test::Property toddHoward("ToddHowardTransform", isa, 1e-5f, 64);
+		Test::Property localOffset("TransformLocalOffset", isa, 2e-4f, 64);
+		Test::Property decomposeBasis("DecomposeToBasis(basis)", isa, 1e-2f, 64);
+		Test::Property eulerBasis("DecomposeToBasis(rotation) axes", isa, 1e-5f, 64);
+		Test::Property decomposeEuler("DecomposeToBasis(rotation)", isa, 1e-2f, 64);
+
+		for (size_t i = 0; i < sampleCount; i++) {
+			const auto pitch = in.Pitch();
+			const auto yaw = in.Yaw();
+
+			const auto angles = glm::vec4(pitch, yaw, pitch - yaw, yaw * 3.0f);
+			glm::vec4 sines, cosines;
+			mmath::SinCos(angles, sines, cosines);
+			sinCos.Compare(sines, glm::vec4(glm::sin(glm::dvec4(angles))));
+			sinCos.Compare(cosines, glm::vec4(glm::cos(glm::dvec4(angles))));
+
+			const auto fwd = glm::vec3(0.0f, 1.0f, 0.0f);
+			viewVector.Compare(mmath::GetViewVector(fwd, pitch, yaw), mmath::Scalar::GetViewVector(fwd, pitch, yaw));
+
+			const auto basis = mmath::ComputeCameraBasis(pitch, yaw);
+			const auto frozenView = Frozen::ViewMatrix(pitch, yaw);
+			for (auto c = 0; c < 4; c++)
+				viewMatrix.Compare(basis.view[c], frozenView[c]);
+
+			const auto mat = mmath::ToddHowardTransform(pitch, yaw);
+			const auto refMat = mmath::Scalar::ToddHowardTransform(pitch, yaw);
+			for (auto r = 0; r < 3; r++)
+				for (auto c = 0; c < 3; c++)
+					toddHoward.Compare(mat.data[r][c], refMat.data[r][c]);
+
+			const auto local = in.Point(500.0f);
+			localOffset.Compare(mmath::TransformLocalOffset(local, basis), Frozen::TransformLocalOffset(local, pitch, yaw));
+
+			const auto point = in.Point(1000.0f);
+			const auto frozenCoef = glm::dvec3(glm::transpose(glm::dmat3(glm::mat3(frozenView))) * glm::dvec3(point));
+			decomposeBasis.Compare(mmath::DecomposeToBasis(point, basis), glm::vec3(frozenCoef));
+
+			const auto rotation = glm::vec3(pitch, in.Uniform(-0.2f, 0.2f), yaw);
+			glm::vec3 f, r, u, coef, refF, refR, refU, refCoef;
+			mmath::DecomposeToBasis(point, rotation, f, r, u, coef);
+			mmath::Scalar::DecomposeToBasis(point, rotation, refF, refR, refU, refCoef);
+			decomposeEuler.Compare(coef, refCoef);
+			eulerBasis.Compare(f, refF);
+			eulerBasis.Compare(r, refR);
+			eulerBasis.Compare(u, refU);
+		}
+
+		CHECK_PROPERTY(sinCos);
+		CHECK_PROPERTY(viewVector);
+		CHECK_PROPERTY(viewMatrix);
+		CHECK_PROPERTY(toddHoward);
+		CHECK_PROPERTY(localOffset);
+		CHECK_PROPERTY(decomposeBasis);
+		CHECK_PROPERTY(eulerBasis);
+		CHECK_PROPERTY(decomposeEuler);
+	});
+}
+
+// Float interpolation and the spring against their double precision counterparts
+TEST_CASE(InterpolationMatchesFrozenMath) {
+	constexpr auto isa = "any";
+	Inputs in;
+	Test::Property interpolate("Interpolate<vec3>", isa, 5e-2f, 4);
+	Test::Property spring("CriticalSpring", isa, 5e-2f, 16);
+
+	for (size_t i = 0; i < sampleCount; i++) {
+		// World space, which is where float precision runs out first
+		const auto from = in.Point(200000.0f);
+		const auto to = from + in.Point(1000.0f);
+		const auto scalar = in.Uniform(0.0f, 1.0f);
+		interpolate.Compare(mmath::Interpolate<glm::vec3, float>(from, to, scalar), Frozen::Interpolate(from, to, scalar));
+
+		// Follow a moving target for a few frames and compare where each spring ends up
+		auto position = glm::vec4(from, 0.0f);
+		auto velocity = glm::vec4(in.Point(300.0f), 0.0f);
+		auto refPosition = glm::dvec3(position);
+		auto refVelocity = glm::dvec3(velocity);
+		const auto omegaXY = 2.0f / in.Uniform(0.05f, 2.0f);
+		const auto omegaZ = 2.0f / in.Uniform(0.05f, 2.0f);
+		for (auto frame = 0; frame < 8; frame++) {
+			const auto target = to + in.Point(50.0f);
+			const auto delta = in.Uniform(1.0f / 500.0f, 1.0f / 10.0f);
+			mmath::CriticalSpring(position, velocity, glm::vec4(target, 0.0f), omegaXY, omegaZ, delta);
+			Frozen::CriticalSpring(refPosition, refVelocity, target, omegaXY, omegaZ, delta);
+		}
+		spring.Compare(static_cast<glm::vec3>(position), glm::vec3(refPosition));
+	}
+
+	CHECK_PROPERTY(interpolate);
+	CHECK_PROPERTY(spring);
+}
+
+// Easing in float against the double precision the camera uses today
+TEST_CASE(FloatEasingMatchesDouble) {
+	constexpr auto isa = "any";
+	Inputs in;
+	for (const auto& entry : Config::scalarMethodRevLookup) {
+		Test::Property easing(entry.second.c_str(), isa, 1e-5f, 16);
+		for (size_t i = 0; i < sampleCount; i++) {
+			const auto t = in.Uniform(0.0f, 1.0f);
+			easing.Compare(
+				mmath::RunScalarFunction<float>(entry.first, t),
+				static_cast<float>(mmath::RunScalarFunction<double>(entry.first, static_cast<double>(t)))
+			);
+		}
+		CHECK_PROPERTY(easing);
+	}
+}
\ No newline at end of file
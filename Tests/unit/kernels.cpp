@@ -0,0 +1,239 @@
+// Each kernel table against the mmath::Scalar reference implementations
+#include "test.h"
+#include <random>
+
+namespace {
+	bool NearlyEqual(float a, float b) noexcept {
+		return glm::abs(a - b) <= 1e-5f;
+	}
+
+	bool NearlyEqual(const glm::vec3& a, const glm::vec3& b) noexcept {
+		return NearlyEqual(a.x, b.x) && NearlyEqual(a.y, b.y) && NearlyEqual(a.z, b.z);
+	}
+
+	bool NearlyEqual(const glm::vec4& a, const glm::vec4& b) noexcept {
+		return NearlyEqual(a.x, b.x) && NearlyEqual(a.y, b.y) && NearlyEqual(a.z, b.z) && NearlyEqual(a.w, b.w);
+	}
+
+	// Compares the active kernels against the scalar reference for one rotation
+	bool MatchesReference(float pitch, float yaw, const glm::vec3& point) noexcept {
+		glm::vec4 sines, cosines, refSines, refCosines;
+		const auto angles = glm::vec4(pitch, yaw, pitch - yaw, yaw * 3.0f);
+		mmath::SinCos(angles, sines, cosines);
+		mmath::Scalar::SinCos(angles, refSines, refCosines);
+		if (!NearlyEqual(sines, refSines) || !NearlyEqual(cosines, refCosines)) return false;
+
+		const auto view = mmath::GetViewMatrix(pitch, yaw);
+		const auto refView = mmath::Scalar::GetViewMatrix(pitch, yaw);
+		for (auto i = 0; i < 4; i++)
+			if (!NearlyEqual(view[i], refView[i])) return false;
+
+		const auto fwd = glm::vec3(0.0f, 1.0f, 0.0f);
+		if (!NearlyEqual(mmath::GetViewVector(fwd, pitch, yaw), mmath::Scalar::GetViewVector(fwd, pitch, yaw)))
+			return false;
+
+		const auto mat = mmath::ToddHowardTransform(pitch, yaw);
+		const auto refMat = mmath::Scalar::ToddHowardTransform(pitch, yaw);
+		for (auto i = 0; i < 3; i++)
+			for (auto j = 0; j < 3; j++)
+				if (!NearlyEqual(mat.data[i][j], refMat.data[i][j])) return false;
+
+		glm::vec3 f, r, u, c, refF, refR, refU, refC;
+		const auto rot = glm::vec3(pitch, yaw * 0.5f, yaw);
+		mmath::DecomposeToBasis(point, rot, f, r, u, c);
+		mmath::Scalar::DecomposeToBasis(point, rot, refF, refR, refU, refC);
+		return NearlyEqual(f, refF) && NearlyEqual(r, refR) && NearlyEqual(u, refU) &&
+			glm::all(glm::lessThanEqual(glm::abs(c - refC), glm::vec3(1e-5f * glm::length(point))));
+	}
+
+	// Projects a handful of points around the camera, some of them behind it, with the batched kernel and the
+	// per point reference
+	bool ProjectionMatchesReference(float pitch, float yaw, const glm::vec3& point) noexcept {
+		NiFrustum frustum;
+		frustum.m_fLeft = -0.83f;
+		frustum.m_fRight = 0.83f;
+		frustum.m_fTop = 0.47f;
+		frustum.m_fBottom = -0.47f;
+		frustum.m_fNear = 15.0f;
+		frustum.m_fFar = 353840.0f;
+		frustum.m_bOrtho = false;
+
+		mmath::NiMatrix44 worldToScreen;
+		mmath::ComputeWorldToScreen(frustum, mmath::ToddHowardTransform(pitch, yaw), point, worldToScreen);
+
+		auto port = NiRect<float>();
+		port.m_left = 0.0f;
+		port.m_right = 1920.0f;
+		port.m_top = 0.0f;
+		port.m_bottom = 1080.0f;
+
+		// 7 points leaves a partial batch at the end
+		glm::vec3 points[7];
+		for (auto i = 0; i < 7; i++)
+			points[i] = point + glm::vec3(100.0f * (i - 3), 250.0f * glm::cos(i * 1.3f), 40.0f * (i % 3));
+
+		glm::vec3 screen[7];
+		uint8_t visible[7];
+		mmath::ProjectPoints(worldToScreen, port, points, 7, screen, visible);
+		for (auto i = 0; i < 7; i++) {
+			glm::vec3 refScreen;
+			const auto refVisible = mmath::Scalar::ProjectPoint(worldToScreen, port, points[i], refScreen);
+			if (refVisible != (visible[i] != 0)) return false;
+			if (refVisible && glm::length(refScreen - screen[i]) > 1e-3f * glm::max(1.0f, glm::length(refScreen)))
+				return false;
+		}
+		return true;
+	}
+}
+
+TEST_CASE(KernelsMatchScalarReference) {
+	Test::ForEachISA([](const char* isa) {
+		for (auto pitch = -1.5f; pitch <= 1.5f; pitch += 0.25f) {
+			for (auto yaw = -glm::pi<float>(); yaw <= glm::pi<float>(); yaw += 0.3f) {
+				const auto point = glm::vec3(120.0f, -35.5f, 64.0f);
+				const auto matches = MatchesReference(pitch, yaw, point) && ProjectionMatchesReference(pitch, yaw, point);
+				CHECK(matches);
+				if (!matches) {
+					_ERROR("%s math kernels do not match the reference at pitch %f, yaw %f", isa, pitch, yaw);
+					return;
+				}
+			}
+		}
+	});
+}
+
+// The sine and cosine kernel over the whole range it claims to be accurate for
+TEST_CASE(SinCosKernelWithinUlpBound) {
+	Test::ForEachISA([](const char* isa) {
+		const auto& kernels = mmath::SIMD::GetKernels();
+		std::mt19937 rng(0x51C05);
+		for (const auto range : { glm::two_pi<float>(), 100.0f, 8192.0f }) {
+			std::uniform_real_distribution<float> angle(-range, range);
+			// Either within one float step of 1.0 or a few ULP, the ULP distance blows up close to zero crossings
+			Test::Property property("SinCos kernel", isa, 1.0f / 8388608.0f, 4);
+			for (size_t i = 0; i < 50000; i++) {
+				float angles[4] = { angle(rng), angle(rng), angle(rng), angle(rng) };
+				float sines[4], cosines[4];
+				kernels.sinCos(angles, sines, cosines);
+				for (auto j = 0; j < 4; j++) {
+					property.Compare(sines[j], static_cast<float>(std::sin(static_cast<double>(angles[j]))));
+					property.Compare(cosines[j], static_cast<float>(std::cos(static_cast<double>(angles[j]))));
+				}
+			}
+			CHECK_PROPERTY(property);
+		}
+	});
+}
+
+// The rotation kernels against the same closed forms evaluated in double precision
+TEST_CASE(BasisKernelsWithinUlpBound) {
+	Test::ForEachISA([](const char* isa) {
+		const auto& kernels = mmath::SIMD::GetKernels();
+		std::mt19937 rng(0xBA515);
+		std::uniform_real_distribution<float> pitch(-1.5f, 1.5f);
+		std::uniform_real_distribution<float> yaw(-glm::pi<float>(), glm::pi<float>());
+		std::uniform_real_distribution<float> roll(-0.2f, 0.2f);
+		Test::Property cameraBasis("CameraBasis kernel", isa, 2.5e-7f, 8);
+		Test::Property eulerBasis("EulerBasis kernel", isa, 2.5e-7f, 8);
+
+		for (size_t i = 0; i < 50000; i++) {
+			const auto p = pitch(rng);
+			const auto y = yaw(rng);
+			float sines[2], cosines[2];
+			glm::vec4 columns[3];
+			kernels.cameraBasis(p, y, sines, cosines, &columns[0].x);
+
+			const auto sp = glm::sin(static_cast<double>(p));
+			const auto cp = glm::cos(static_cast<double>(p));
+			const auto sy = glm::sin(static_cast<double>(y));
+			const auto cy = glm::cos(static_cast<double>(y));
+			cameraBasis.Compare(columns[0], glm::vec4(glm::dvec4(cy, -sy, 0.0, 0.0)));
+			cameraBasis.Compare(columns[1], glm::vec4(glm::dvec4(sy * cp, cy * cp, -sp, 0.0)));
+			cameraBasis.Compare(columns[2], glm::vec4(glm::dvec4(sy * sp, cy * sp, cp, 0.0)));
+
+			const auto rotation = glm::vec3(p, roll(rng), y);
+			kernels.eulerBasis(&rotation.x, &columns[0].x);
+			const auto s = glm::sin(glm::dvec3(rotation));
+			const auto c = glm::cos(glm::dvec3(rotation));
+			eulerBasis.Compare(columns[0], glm::vec4(glm::dvec4(c.y * c.z, -c.y * s.z, s.y, 0.0)));
+			eulerBasis.Compare(columns[1], glm::vec4(glm::dvec4(
+				c.z * s.x * s.y + c.x * s.z, c.x * c.z - s.x * s.y * s.z, -c.y * s.x, 0.0
+			)));
+			eulerBasis.Compare(columns[2], glm::vec4(glm::dvec4(
+				-c.x * c.z * s.y + s.x * s.z, c.z * s.x + c.x * s.y * s.z, c.x * c.y, 0.0
+			)));
+		}
+
+		CHECK_PROPERTY(cameraBasis);
+		CHECK_PROPERTY(eulerBasis);
+	});
+}
+
+// A 3 term dot product in float is within 3 rounding errors of the sum of the magnitudes of its terms
+TEST_CASE(ProjectKernelWithinErrorBound) {
+	Test::ForEachISA([](const char* isa) {
+		const auto& kernels = mmath::SIMD::GetKernels();
+		std::mt19937 rng(0xD07);
+		std::uniform_real_distribution<float> angle(-glm::pi<float>(), glm::pi<float>());
+		std::uniform_real_distribution<float> extent(-200000.0f, 200000.0f);
+		// gamma(3) = 3u / (1 - 3u), with u the unit roundoff
+		constexpr auto u = std::numeric_limits<float>::epsilon() * 0.5;
+		constexpr auto bound = 3.0 * u / (1.0 - 3.0 * u);
+
+		auto worst = 0.0;
+		for (size_t i = 0; i < 50000; i++) {
+			const auto rotation = glm::vec3(angle(rng), angle(rng), angle(rng));
+			glm::vec4 columns[3];
+			kernels.eulerBasis(&rotation.x, &columns[0].x);
+
+			const auto point = glm::vec3(extent(rng), extent(rng), extent(rng));
+			glm::vec3 coef;
+			kernels.project(&point.x, &columns[0].x, &coef.x);
+
+			for (auto j = 0; j < 3; j++) {
+				const auto column = glm::dvec3(columns[j]);
+				const auto exact = glm::dot(column, glm::dvec3(point));
+				const auto magnitude = glm::dot(glm::abs(column), glm::abs(glm::dvec3(point)));
+				if (magnitude > 0.0)
+					worst = glm::max(worst, glm::abs(static_cast<double>(coef[j]) - exact) / magnitude);
+			}
+		}
+
+		_MESSAGE("Project kernel [%s]: max relative error %g (bound %g)", isa, worst, bound);
+		CHECK(worst <= bound);
+	});
+}
+
+// Channel interpolation against Interpolate<float, float>, including the partial batch at the end
+TEST_CASE(InterpolateKernelMatchesReference) {
+	Test::ForEachISA([](const char* isa) {
+		const auto& kernels = mmath::SIMD::GetKernels();
+		std::mt19937 rng(0x1E4);
+		std::uniform_real_distribution<float> value(-5000.0f, 5000.0f);
+		// Covers both ends being clamped
+		std::uniform_real_distribution<float> scalar(-0.25f, 1.25f);
+		// gcc and clang may fuse the multiply and add, allow a couple of rounding steps at the largest values
+		Test::Property property("Interpolate kernel", isa, 1e-3f, 1);
+
+		constexpr size_t count = 11;
+		float from[count], to[count], scalars[count], out[count], ref[count];
+		for (size_t i = 0; i < 10000; i++) {
+			for (size_t j = 0; j < count; j++) {
+				from[j] = value(rng);
+				to[j] = value(rng);
+				scalars[j] = scalar(rng);
+			}
+			// Exactly on the ends too
+			scalars[0] = 0.0f;
+			scalars[1] = 1.0f;
+
+			const auto n = 1 + i % count;
+			kernels.interpolate(from, to, scalars, n, out);
+			mmath::Scalar::InterpolateChannels(from, to, scalars, n, ref);
+			for (size_t j = 0; j < n; j++)
+				property.Compare(out[j], ref[j]);
+		}
+
+		CHECK_PROPERTY(property);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+// Debug line vertex packing
+#include "test.h"
+#include "line_packing.h"
+#include <set>
+
+namespace {
+	// Packs a box and checks every edge comes out exactly once
+	void CheckPackBox() {
+		// Put each corner somewhere unique so vertices can be traced back to it
+		DebugDrawing::BoxCorners corners;
+		for (size_t i = 0; i < corners.size(); i++)
+			corners[i] = { static_cast<float>(i), static_cast<float>(i) * -2.0f };
+
+		DebugDrawing::PackedVertex out[DebugDrawing::boxVertexCount];
+		const auto color = glm::vec3(0.25f, 0.5f, 0.75f);
+		const auto written = DebugDrawing::PackBox(corners, color, out);
+		CHECK(written == DebugDrawing::boxVertexCount);
+
+		const auto cornerOf = [&corners](const DebugDrawing::PackedVertex& vertex) noexcept {
+			for (size_t i = 0; i < corners.size(); i++)
+				if (vertex.position == glm::vec4(corners[i], 0.0f, 1.0f)) return static_cast<int>(i);
+			return -1;
+		};
+
+		std::set<std::pair<int, int>> edges;
+		std::array<int, 8> uses = {};
+		for (size_t i = 0; i < written; i += 2) {
+			CHECK(out[i].color == glm::vec4(color, 1.0f));
+			CHECK(out[i + 1].color == glm::vec4(color, 1.0f));
+
+			const auto a = cornerOf(out[i]);
+			const auto b = cornerOf(out[i + 1]);
+			CHECK(a >= 0 && b >= 0);
+			if (a < 0 || b < 0) return;
+
+			// Corners are numbered with x in bit 0, depth in bit 1 and height in bit 2, edges differ in one of them
+			const auto differ = a ^ b;
+			CHECK(differ == 1 || differ == 2 || differ == 4);
+			edges.insert({ glm::min(a, b), glm::max(a, b) });
+			uses[a]++;
+			uses[b]++;
+		}
+
+		CHECK(edges.size() == 12);
+		for (const auto count : uses)
+			CHECK(count == 3);
+	}
+}
+
+TEST_CASE(PackLineWritesBothEnds) {
+	Test::ForEachISA([](const char*) {
+		DebugDrawing::PackedVertex out[DebugDrawing::lineVertexCount];
+		const auto written = DebugDrawing::PackLine({ -0.5f, 0.25f }, { 1.0f, 0.0f, 0.0f }, { 0.75f, -1.0f },
+			{ 0.0f, 0.5f, 1.0f }, out);
+
+		CHECK(written == DebugDrawing::lineVertexCount);
+		CHECK(out[0].position == glm::vec4(-0.5f, 0.25f, 0.0f, 1.0f));
+		CHECK(out[0].color == glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+		CHECK(out[1].position == glm::vec4(0.75f, -1.0f, 0.0f, 1.0f));
+		CHECK(out[1].color == glm::vec4(0.0f, 0.5f, 1.0f, 1.0f));
+	});
+}
+
+TEST_CASE(PackBoxWritesEveryEdgeOnce) {
+	Test::ForEachISA([](const char*) { CheckPackBox(); });
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Runs the math tests, optionally only the cases whose name contains the first argument
+#include "test.h"
+#include "mmath_simd.h"
+
+namespace {
+	typedef struct testCase {
+		const char* name;
+		Test::CaseFn fn;
+	} TestCase;
+
+	std::vector<TestCase>& GetCases() noexcept {
+		static std::vector<TestCase> cases;
+		return cases;
+	}
+
+	bool currentFailed = false;
+}
+
+// Adds a case to the run list, called from TEST_CASE at static init
+bool Test::Register(const char* name, CaseFn fn) noexcept {
+	GetCases().push_back({ name, fn });
+	return true;
+}
+
+// Marks the running case as failed
+void Test::Fail(const char* file, int line, const char* expr) noexcept {
+	_ERROR("%s(%d): check failed: %s", file, line, expr);
+	currentFailed = true;
+}
+
+// Runs every case whose name contains filter, returns the number that failed
+size_t Test::RunAll(const char* filter) noexcept {
+	size_t failed = 0;
+	for (const auto& test : GetCases()) {
+		if (filter && !std::strstr(test.name, filter)) continue;
+
+		currentFailed = false;
+		test.fn();
+		std::printf("%s %s\n", currentFailed ? "FAIL" : "pass", test.name);
+		if (currentFailed) failed++;
+	}
+	return failed;
+}
+
+// Distance between two floats in units in the last place
+uint32_t Test::UlpDistance(float a, float b) noexcept {
+	if (a == b) return 0;
+	if (glm::isnan(a) || glm::isnan(b)) return std::numeric_limits<uint32_t>::max();
+
+	int32_t ia, ib;
+	std::memcpy(&ia, &a, sizeof(float));
+	std::memcpy(&ib, &b, sizeof(float));
+	// Map the sign-magnitude bits on to a line so neighbouring floats are neighbouring integers
+	const auto ordered = [](int32_t i) noexcept {
+		return i < 0 ? static_cast<int64_t>(std::numeric_limits<int32_t>::min()) - i : static_cast<int64_t>(i);
+	};
+	const auto distance = glm::abs(ordered(ia) - ordered(ib));
+	return static_cast<uint32_t>(glm::min(distance, static_cast<int64_t>(std::numeric_limits<uint32_t>::max())));
+}
+
+int main(int argc, char** argv) {
+	mmath::SIMD::Initialize();
+
+	const auto failed = Test::RunAll(argc > 1 ? argv[1] : nullptr);
+	if (failed > 0) {
+		std::printf("%zu case(s) failed\n", failed);
+		return 1;
+	}
+	std::printf("All cases passed\n");
+	return 0;
+}
\ No newline at end of file
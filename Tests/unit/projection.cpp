@@ -0,0 +1,234 @@
+// The world to screen matrix and point projection, checked against where the view frustum has to land
+#include "test.h"
+
+namespace {
+	// Inputs and output of NiCamera::UpdateWorldToScreenMtx, captured from the game
+	typedef struct worldToScreenCase {
+		bool ortho;
+		float frustum[6];
+		float rotation[9];
+		float position[3];
+		float engine[16];
+	} WorldToScreenCase;
+
+	const std::vector<WorldToScreenCase> worldToScreenCases = {
+#include "../fixtures/world_to_screen.inl"
+	};
+
+	// Inputs and output of NiCamera::WorldPtToScreenPt3, captured from the game
+	typedef struct projectionCase {
+		float worldToScreen[16];
+		float port[4];
+		float point[3];
+		bool visible;
+		float screen[3];
+	} ProjectionCase;
+
+	const std::vector<ProjectionCase> projectionCases = {
+#include "../fixtures/projection.inl"
+	};
+
+	// NiCameras look down their local X axis, with Y up and Z right
+	typedef struct cameraAxes {
+		glm::vec3 dir;
+		glm::vec3 up;
+		glm::vec3 right;
+	} CameraAxes;
+
+	CameraAxes GetAxes(const NiMatrix33& rotation) noexcept {
+		return {
+			{ rotation.data[0][0], rotation.data[1][0], rotation.data[2][0] },
+			{ rotation.data[0][1], rotation.data[1][1], rotation.data[2][1] },
+			{ rotation.data[0][2], rotation.data[1][2], rotation.data[2][2] },
+		};
+	}
+
+	// A viewport that leaves projected points in normalized device coordinates
+	NiRect<float> GetNDCPort() noexcept {
+		auto port = NiRect<float>();
+		port.m_left = -1.0f;
+		port.m_right = 1.0f;
+		port.m_top = 1.0f;
+		port.m_bottom = -1.0f;
+		return port;
+	}
+
+	NiFrustum GetFrustum(bool ortho) noexcept {
+		NiFrustum frustum;
+		frustum.m_bOrtho = ortho;
+		frustum.m_fLeft = ortho ? -960.0f : -0.83f;
+		frustum.m_fRight = ortho ? 960.0f : 0.83f;
+		frustum.m_fTop = ortho ? 540.0f : 0.47f;
+		frustum.m_fBottom = ortho ? -540.0f : -0.47f;
+		frustum.m_fNear = 15.0f;
+		frustum.m_fFar = 353840.0f;
+		return frustum;
+	}
+
+	// Projects the 8 corners of the frustum, which have to land on the corners of the NDC cube
+	bool CornersLandOnTheCube(const NiFrustum& frustum, float pitch, float yaw, const glm::vec3& position) noexcept {
+		const auto rotation = mmath::ToddHowardTransform(pitch, yaw);
+		const auto axes = GetAxes(rotation);
+		mmath::NiMatrix44 worldToScreen;
+		mmath::ComputeWorldToScreen(frustum, rotation, position, worldToScreen);
+
+		const auto port = GetNDCPort();
+		for (const auto depth : { frustum.m_fNear, frustum.m_fFar }) {
+			for (const auto x : { frustum.m_fLeft, frustum.m_fRight }) {
+				for (const auto y : { frustum.m_fBottom, frustum.m_fTop }) {
+					// The planes of a perspective frustum are given at a distance of 1
+					const auto scale = frustum.m_bOrtho ? 1.0f : depth;
+					const auto corner = position + axes.dir * depth + axes.right * (x * scale) + axes.up * (y * scale);
+
+					glm::vec3 screen;
+					if (!mmath::Scalar::ProjectPoint(worldToScreen, port, corner, screen)) return false;
+
+					const auto expected = glm::vec3(
+						x == frustum.m_fLeft ? -1.0f : 1.0f,
+						y == frustum.m_fBottom ? -1.0f : 1.0f,
+						depth == frustum.m_fNear ? 0.0f : 1.0f
+					);
+					if (glm::any(glm::greaterThan(glm::abs(screen - expected), glm::vec3(1e-3f)))) {
+						_ERROR("Frustum corner projected to %f, %f, %f, expected %f, %f, %f",
+							screen.x, screen.y, screen.z, expected.x, expected.y, expected.z);
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+}
+
+TEST_CASE(WorldToScreenMapsTheFrustumToNDC) {
+	const auto position = glm::vec3(-2301.5f, 4410.0f, -120.25f);
+	for (const auto ortho : { false, true }) {
+		const auto frustum = GetFrustum(ortho);
+		for (auto pitch = -1.5f; pitch <= 1.5f; pitch += 0.25f) {
+			for (auto yaw = -glm::pi<float>(); yaw <= glm::pi<float>(); yaw += 0.3f) {
+				const auto ok = CornersLandOnTheCube(frustum, pitch, yaw, position);
+				CHECK(ok);
+				if (!ok) {
+					_ERROR("%s frustum at pitch %f, yaw %f", ortho ? "Orthographic" : "Perspective", pitch, yaw);
+					return;
+				}
+			}
+		}
+	}
+}
+
+// The matrix has to match the one the game built for the same frustum, rotation and position
+TEST_CASE(WorldToScreenMatchesTheEngine) {
+	// With nothing captured there is nothing to compare against, which shouldn't pass quietly
+	CHECK(!worldToScreenCases.empty());
+	if (worldToScreenCases.empty()) {
+		_ERROR("Tests/fixtures/world_to_screen.inl has no cases, capture them with a debug build of the plugin");
+		return;
+	}
+
+	// Near zero the engine's order of operations leaves a few ulp of noise, so that is bounded absolutely
+	auto perspective = Test::Property("ComputeWorldToScreen perspective", "scalar", 1e-6f, 4);
+	auto ortho = Test::Property("ComputeWorldToScreen orthographic", "scalar", 1e-6f, 4);
+	for (const auto& fixture : worldToScreenCases) {
+		NiFrustum frustum;
+		frustum.m_bOrtho = fixture.ortho;
+		frustum.m_fLeft = fixture.frustum[0];
+		frustum.m_fRight = fixture.frustum[1];
+		frustum.m_fTop = fixture.frustum[2];
+		frustum.m_fBottom = fixture.frustum[3];
+		frustum.m_fNear = fixture.frustum[4];
+		frustum.m_fFar = fixture.frustum[5];
+
+		NiMatrix33 rotation;
+		std::memcpy(rotation.data, fixture.rotation, sizeof(rotation.data));
+		const auto position = glm::vec3(fixture.position[0], fixture.position[1], fixture.position[2]);
+
+		mmath::NiMatrix44 worldToScreen;
+		mmath::ComputeWorldToScreen(frustum, rotation, position, worldToScreen);
+		auto& property = fixture.ortho ? ortho : perspective;
+		for (auto i = 0; i < 16; i++)
+			property.Compare((&worldToScreen.data[0][0])[i], fixture.engine[i]);
+	}
+	CHECK_PROPERTY(perspective);
+	CHECK_PROPERTY(ortho);
+}
+
+// Points behind the camera are flagged and zeroed the same as NiCamera::WorldPtToScreenPt3
+TEST_CASE(PointsBehindTheCameraAreHidden) {
+	Test::ForEachISA([](const char* isa) {
+		const auto position = glm::vec3(10.0f, 20.0f, 30.0f);
+		const auto rotation = mmath::ToddHowardTransform(0.3f, 1.1f);
+		const auto axes = GetAxes(rotation);
+		mmath::NiMatrix44 worldToScreen;
+		mmath::ComputeWorldToScreen(GetFrustum(false), rotation, position, worldToScreen);
+
+		// Alternate in front and behind, with a partial batch at the end
+		glm::vec3 points[6];
+		for (auto i = 0; i < 6; i++)
+			points[i] = position + axes.dir * ((i % 2 == 0) ? 500.0f : -500.0f) + axes.right * (20.0f * i);
+
+		glm::vec3 screen[6];
+		uint8_t visible[6];
+		mmath::ProjectPoints(worldToScreen, GetNDCPort(), points, 6, screen, visible);
+		for (auto i = 0; i < 6; i++) {
+			const auto inFront = i % 2 == 0;
+			CHECK((visible[i] != 0) == inFront);
+			if (!inFront) CHECK(screen[i] == glm::vec3(0.0f));
+		}
+		_MESSAGE("Projection of hidden points [%s] checked", isa);
+	});
+}
+
+// Every ISA has to agree with the game on what is visible and where it lands, near plane and behind the camera included
+TEST_CASE(ProjectPointsMatchesTheEngine) {
+	CHECK(!projectionCases.empty());
+	if (projectionCases.empty()) {
+		_ERROR("Tests/fixtures/projection.inl has no cases, capture them with a debug build of the plugin");
+		return;
+	}
+
+	Test::ForEachISA([](const char* isa) {
+		// Depth cancels out near the near plane, the absolute bound covers that
+		auto property = Test::Property("ProjectPoints", isa, 1e-4f, 4);
+		std::vector<glm::vec3> points;
+		std::vector<glm::vec3> screen;
+		std::vector<uint8_t> visible;
+
+		// Rows captured through the same matrix and port are projected together, so they go through the batched path
+		for (size_t first = 0; first < projectionCases.size();) {
+			const auto& batch = projectionCases[first];
+			auto last = first + 1;
+			while (last < projectionCases.size() &&
+				std::memcmp(projectionCases[last].worldToScreen, batch.worldToScreen, sizeof(batch.worldToScreen)) == 0 &&
+				std::memcmp(projectionCases[last].port, batch.port, sizeof(batch.port)) == 0)
+				last++;
+
+			mmath::NiMatrix44 worldToScreen;
+			std::memcpy(worldToScreen.data, batch.worldToScreen, sizeof(worldToScreen.data));
+			auto port = NiRect<float>();
+			port.m_left = batch.port[0];
+			port.m_right = batch.port[1];
+			port.m_top = batch.port[2];
+			port.m_bottom = batch.port[3];
+
+			points.clear();
+			for (auto i = first; i < last; i++)
+				points.emplace_back(projectionCases[i].point[0], projectionCases[i].point[1], projectionCases[i].point[2]);
+			screen.resize(points.size());
+			visible.resize(points.size());
+			mmath::ProjectPoints(worldToScreen, port, points.data(), points.size(), screen.data(), visible.data());
+
+			for (auto i = first; i < last; i++) {
+				const auto& fixture = projectionCases[i];
+				const auto& projected = screen[i - first];
+				CHECK((visible[i - first] != 0) == fixture.visible);
+				if (fixture.visible)
+					property.Compare(projected, glm::vec3(fixture.screen[0], fixture.screen[1], fixture.screen[2]));
+				else
+					CHECK(projected == glm::vec3(0.0f));
+			}
+			first = last;
+		}
+		CHECK_PROPERTY(property);
+	});
+}
\ No newline at end of file
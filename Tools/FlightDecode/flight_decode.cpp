@@ -0,0 +1,98 @@
+// Turns SmoothCam flight recorder traces into CSV
+// Standalone and portable, build with any C++17 compiler:
+//   g++ -std=c++17 -O2 -o flight_decode flight_decode.cpp
+// Usage:
+//   flight_decode SmoothCam_Trace.prev.bin SmoothCam_Trace.bin > trace.csv
+// Files are decoded in the order given, pass the rolled over file first to keep frames in order
+#include <cstdio>
+#include <vector>
+
+#include "../../SmoothCam/include/flight_record.h"
+
+using namespace FlightRecorder;
+
+static_assert(sizeof(float) == 4 && sizeof(double) == 8, "Traces are written with IEEE 754 floats");
+
+namespace {
+	void PrintHeader() {
+		std::printf(
+			"frame,time,frame_delta,camera_state,action_state,weapon_stance,"
+			"collision_hit,aim_hit,aim_hit_character,aim_recast,fixed_step,dialog_open,"
+			"target_x,target_y,target_z,pre_clamp_x,pre_clamp_y,pre_clamp_z,"
+			"post_clamp_x,post_clamp_y,post_clamp_z,position_x,position_y,position_z,"
+			"ray_length,crosshair_x,crosshair_y,dropped,"
+			"setup_us,state_us,aim_cast_us,total_us\n"
+		);
+	}
+
+	void PrintVec(const float(&v)[3]) {
+		std::printf(",%.3f,%.3f,%.3f", v[0], v[1], v[2]);
+	}
+
+	void PrintRecord(const FrameRecord& r) {
+		std::printf("%llu,%.6f,%.6f,%u,%u,%u",
+			static_cast<unsigned long long>(r.frame), r.time, r.frameDelta,
+			r.cameraState, r.actionState, r.weaponStance
+		);
+
+		for (const auto flag : { CollisionHit, AimHit, AimHitCharacter, AimRecast, FixedStep, DialogOpen })
+			std::printf(",%d", (r.flags & flag) != 0 ? 1 : 0);
+
+		PrintVec(r.target);
+		PrintVec(r.preClamp);
+		PrintVec(r.postClamp);
+		PrintVec(r.position);
+		std::printf(",%.3f,%.1f,%.1f,%u", r.rayLength, r.crosshair[0], r.crosshair[1], r.dropped);
+
+		for (const auto micros : r.zoneMicros)
+			std::printf(",%.2f", micros);
+		std::printf("\n");
+	}
+
+	// Returns false if the file isn't a trace we can read
+	bool DecodeFile(const char* path) {
+		auto file = std::fopen(path, "rb");
+		if (!file) {
+			std::fprintf(stderr, "%s: could not open file\n", path);
+			return false;
+		}
+
+		FileHeader header;
+		if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != fileMagic) {
+			std::fprintf(stderr, "%s: not a flight recorder trace\n", path);
+			std::fclose(file);
+			return false;
+		}
+
+		if (header.version != fileVersion || header.recordSize != sizeof(FrameRecord)) {
+			std::fprintf(stderr, "%s: trace version %u, this decoder reads version %u\n",
+				path, header.version, fileVersion);
+			std::fclose(file);
+			return false;
+		}
+
+		std::vector<FrameRecord> records(1024);
+		size_t count;
+		while ((count = std::fread(records.data(), sizeof(FrameRecord), records.size(), file)) > 0) {
+			for (size_t i = 0; i < count; i++)
+				PrintRecord(records[i]);
+		}
+
+		std::fclose(file);
+		return true;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s trace.bin [trace.bin ...] > trace.csv\n", argv[0]);
+		return 1;
+	}
+
+	PrintHeader();
+	auto ok = true;
+	for (auto i = 1; i < argc; i++)
+		ok = DecodeFile(argv[i]) && ok;
+
+	return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -1,4 +1,4 @@
 @echo off
-premake5 --VS_PLATFORM=vs2017 --INTRIN=ON dd
-premake5 --VS_PLATFORM=vs2017 --INTRIN=ON dmake
-premake5 --VS_PLATFORM=vs2017 --INTRIN=ON vs2017
\ No newline at end of file
+premake5 --VS_PLATFORM=vs2017 dd
+premake5 --VS_PLATFORM=vs2017 dmake
+premake5 --VS_PLATFORM=vs2017 vs2017
\ No newline at end of file
@@ -1,4 +0,0 @@
-@echo off
-premake5 --VS_PLATFORM=vs2017 --INTRIN=OFF dd
-premake5 --VS_PLATFORM=vs2017 --INTRIN=OFF dmake
-premake5 --VS_PLATFORM=vs2017 --INTRIN=OFF vs2017
\ No newline at end of file
@@ -1,4 +1,4 @@
 @echo off
-premake5 --VS_PLATFORM=vs2019 --INTRIN=ON dd
-premake5 --VS_PLATFORM=vs2019 --INTRIN=ON dmake
-premake5 --VS_PLATFORM=vs2019 --INTRIN=ON vs2019
\ No newline at end of file
+premake5 --VS_PLATFORM=vs2019 dd
+premake5 --VS_PLATFORM=vs2019 dmake
+premake5 --VS_PLATFORM=vs2019 vs2019
\ No newline at end of file
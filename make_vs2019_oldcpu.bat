@@ -1,4 +0,0 @@
-@echo off
-premake5 --VS_PLATFORM=vs2019 --INTRIN=OFF dd
-premake5 --VS_PLATFORM=vs2019 --INTRIN=OFF dmake
-premake5 --VS_PLATFORM=vs2019 --INTRIN=OFF vs2019
\ No newline at end of file
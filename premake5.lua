@@ -8,27 +8,12 @@ newoption {
 	}
 }
 
-newoption {
-	trigger = "INTRIN",
-	value = "ON",
-	description = "Enable use of hardware SIMD intrinsics.",
-	allowed = {
-		{ "ON", "Use SIMD instructions" },
-		{ "OFF", "Disable SIMD instructions" },
-	}
-}
-
-if not _OPTIONS["VS_PLATFORM"] then
+if os.target() == "windows" and not _OPTIONS["VS_PLATFORM"] then
 	return error( "No visual studio platform selected, please set --VS_PLATFORM to vs2017 or vs2019" )
 end
 
-if _OPTIONS["INTRIN"] == "ON" then
-	_SIMD_MODE = "AVX"
-	print "Using AVX instructions"
-else
-	_SIMD_MODE = "SSE"
-	print "Building for old CPUs"
-end
+-- Everything, dependencies included, targets the baseline x64 instruction set so one DLL runs on every CPU
+-- The math kernels in SmoothCam/source/simd are built for each ISA we support and selected at runtime
 
 local function rewriteFile(strPath, strData)
 	local f = io.open(strPath, "w")
@@ -153,6 +138,12 @@ newaction {
 	end,
 }
 
+-- The math tests and benchmarks build anywhere, the plugin only on windows
+dofile( "BuildScripts/project_tests.lua" )
+if os.target() ~= "windows" then
+	return
+end
+
 workspace "SmoothCam"
 	architecture "x64"
 	configurations { "Debug", "Release" }
@@ -176,7 +167,7 @@ project "SmoothCam"
 	objdir( "SmoothCam/bin-obj/".. outputDir.. "/%{prj.name}" )
 	dependson { "common_skse64", "skse64_common", "skse64", "PolyHook2" }
 
-	files { "SmoothCam/**.h", "SmoothCam/**.cpp", "SmoothCam/**.rc", "SmoothCam/**.def", "SmoothCam/**.ini" }
+	files { "SmoothCam/**.h", "SmoothCam/**.inl", "SmoothCam/**.cpp", "SmoothCam/**.rc", "SmoothCam/**.def", "SmoothCam/**.ini" }
 	pchheader "pch.h"
 	pchsource "SmoothCam/source/pch.cpp"
 	forceincludes {
@@ -197,11 +188,26 @@ project "SmoothCam"
 	filter "system:windows"
 		systemversion "latest"
 		debugdir( "../bin/".. outputDir.. "/%{prj.name}" )
-		vectorextensions( _SIMD_MODE )
+		vectorextensions "SSE2"
 		characterset "Unicode"
 		intrinsics "On"
 		fpu "Hardware"
 
+	-- Keep the PCH out of the kernels, inline code from it would otherwise be compiled for the wrong CPU
+	filter "files:SmoothCam/source/simd/kernels_*.cpp"
+		flags { "NoPCH" }
+		removeforceincludes {
+			"../Deps/skse64_2_00_17/src/common/IPrefix.h",
+			"../SmoothCam/include/addrlib/skse_macros.h",
+			"pch.h"
+		}
+
+	filter "files:SmoothCam/source/simd/kernels_avx.cpp"
+		vectorextensions "AVX"
+
+	filter "files:SmoothCam/source/simd/kernels_avx2.cpp"
+		vectorextensions "AVX2"
+
 	filter "configurations:Debug"
 		defines { "DEBUG", "SMOOTHCAM_IMPL" }
 		symbols "On"